@@ -0,0 +1,53 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../xmlSerialization.hpp"
+
+using namespace xmlSerialization;
+
+// Decoding time of a nested map, read through the DOM and through the pull parser.
+// Build and run with `make bench`.
+
+struct person {
+    std::string name;
+    int age;
+    std::vector<int> scores;
+    REGISTER_XMLSERIALIZATION(name, age, scores);
+};
+
+template<typename Run>
+double millisecondsPerRun(int runs, Run run) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        run();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / runs;
+}
+
+int main() {
+    std::map<std::string, std::vector<person>> groups;
+    for (int group = 0; group < 200; ++group) {
+        std::vector<person>& people = groups["group_" + std::to_string(group)];
+        for (int i = 0; i < 50; ++i) {
+            people.push_back({"person_" + std::to_string(i) + "_with_a_name_longer_than_sso", i, std::vector<int>(20, i)});
+        }
+    }
+    const int runs = 10;
+    XmlContext& context = XmlContext::local();
+    for (XmlMode mode : {XmlDefault, Compact}) {
+        std::string text = serialize_xml(groups, context, mode);
+        std::map<std::string, std::vector<person>> decoded;
+        double dom = millisecondsPerRun(runs, [&] {
+            deserialize_xml(decoded, text.c_str(), context, mode);
+        });
+        double pull = millisecondsPerRun(runs, [&] {
+            deserialize_xml(decoded, text.c_str(), context, mode | Streaming);
+        });
+        std::cout << (mode & Compact ? "compact" : "default") << ": " << text.size() / 1024 << " KiB, "
+                  << "DOM " << dom << " ms, pull " << pull << " ms" << std::endl;
+    }
+    return 0;
+}
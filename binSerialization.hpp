@@ -3,15 +3,122 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <map>
 #include <set>
 #include <list>
 #include <string>
+#include <bitset>
+#include <array>
+#include <algorithm>
+#include <tuple>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <bit>
+#include <stdexcept>
 #include <type_traits>
+#include "streamVByte.hpp"
+#include "gorilla.hpp"
+#include "bitPacking.hpp"
+#include "mappedFile.hpp"
+#include "generator.hpp"
 
 namespace binSerialization {
 
+    // Encoding modes, combined with `|` and passed to serialize / deserialize.
+    // A file must be read back with the same mode it was written with.
+    enum Mode : unsigned {
+        Default = 0,
+        StringDictionary = 1u << 0,     // write each distinct std::string once, then refer to it by id
+        Columnar = 1u << 1,             // write a vector of registered structs member by member
+        StreamVByte = 1u << 2,          // write a vector of 32-bit integers with the Stream VByte codec
+        XorFloat = 1u << 3,             // Gorilla XOR compression for vectors of float / double and of (timestamp, value) pairs
+        DeltaOfDelta = 1u << 4,         // delta-of-delta compression for vectors of 64-bit integers
+        BitPacked = 1u << 5,            // frame-of-reference bit packing for vectors of integers and enums; eight flags per byte for std::vector<bool> and std::bitset
+        TypeHeader = 1u << 6,           // start the file with a fingerprint of the type, checked on load
+        SmallString = 1u << 7,          // one-byte length for strings shorter than 255 bytes
+        ReuseCapacity = 1u << 8,        // decode into the existing elements and nodes instead of clearing (reading only)
+    };
+
+    constexpr Mode operator|(Mode a, Mode b) {
+        return static_cast<Mode>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    // Per-call state shared by every overload working on the same stream.
+    // It is attached to the stream through pword(), so the overloads keep their (value, stream) signature.
+    struct Context {
+        explicit Context(Mode mode = Default) : mode(mode) {}
+
+        Mode mode;
+        std::unordered_map<std::string, size_t> stringIds;  // writer: string -> dictionary id
+        std::vector<std::string> strings;                   // reader: dictionary id -> string
+    };
+
+    inline int contextIndex() {
+        static const int index = std::ios_base::xalloc();
+        return index;
+    }
+
+    inline Context* contextOf(std::ios_base& stream) {
+        return static_cast<Context*>(stream.pword(contextIndex()));
+    }
+
+    inline Mode modeOf(std::ios_base& stream) {
+        Context* context = contextOf(stream);
+        return context ? context->mode : Default;
+    }
+
+    // Add modes to the stream's context for the lifetime of the guard, attaching a context if there is none.
+    class ModeGuard {
+    public:
+        ModeGuard(std::ios_base& stream, Mode mode) : context_(contextOf(stream)) {
+            if (!context_) {
+                context_ = &local_;
+                stream.pword(contextIndex()) = &local_;
+                stream_ = &stream;
+            }
+            previous_ = context_->mode;
+            context_->mode = previous_ | mode;
+        }
+        ~ModeGuard() {
+            context_->mode = previous_;
+            if (stream_) {
+                stream_->pword(contextIndex()) = nullptr;
+            }
+        }
+        ModeGuard(const ModeGuard&) = delete;
+        ModeGuard& operator=(const ModeGuard&) = delete;
+    private:
+        Context local_;
+        Context* context_;
+        std::ios_base* stream_ = nullptr;
+        Mode previous_;
+    };
+
+    // Attach a context to a stream for the lifetime of the guard.
+    class ContextGuard {
+    public:
+        ContextGuard(std::ios_base& stream, Context& context) : stream_(stream), previous_(stream.pword(contextIndex())) {
+            stream_.pword(contextIndex()) = &context;
+        }
+        ~ContextGuard() {
+            stream_.pword(contextIndex()) = previous_;
+        }
+        ContextGuard(const ContextGuard&) = delete;
+        ContextGuard& operator=(const ContextGuard&) = delete;
+    private:
+        std::ios_base& stream_;
+        void* previous_;
+    };
+
     // Register functions
     template <typename Func, typename... Members>
     void registerConstFunction(const Func& func, const Members&... members) {
@@ -19,10 +126,175 @@ namespace binSerialization {
     }
 
     template <typename Func, typename... Members>
-    void registerFunction(const Func& func, Members&... members) {
+    void registerFunction(const Func& func, Members&&... members) {
         (func(members), ...);
     }
 
+    // A member serialized with extra modes, e.g. REGISTER_BINSERIALIZATION(withMode<XorFloat>(samples)).
+    template<typename T, Mode M>
+    struct WithMode {
+        T& value;
+    };
+
+    template<Mode M, typename T>
+    constexpr WithMode<T, M> withMode(T& value) {
+        return {value};
+    }
+
+    // The registered members as a tuple of references, in registration order.
+    template <typename... Members>
+    constexpr auto memberTuple(Members&&... members) {
+        return std::tuple<Members...>(std::forward<Members>(members)...);
+    }
+
+    // Polymorphic types registered with REGISTER_BINSERIALIZATION_BASE / REGISTER_BINSERIALIZATION_DERIVED.
+    // Every derived type has a small numeric id; the registry of a hierarchy is a dense table of factories
+    // indexed by that id, so loading a std::unique_ptr<Base> is one array lookup and one virtual call.
+    // Id 0 is reserved for null pointers.
+    template<typename Base>
+    class PolymorphicRegistry {
+    public:
+        using Factory = std::unique_ptr<Base> (*)();
+
+        static bool add(size_t id, Factory factory) {
+            if (id == 0) {
+                throw std::runtime_error("Type id 0 is reserved for null pointers!");
+            }
+            std::vector<Factory>& table = factories();
+            if (table.size() <= id) {
+                table.resize(id + 1, nullptr);
+            }
+            if (table[id] != nullptr) {
+                throw std::runtime_error("Type id is registered twice!");
+            }
+            table[id] = factory;
+            return true;
+        }
+
+        static std::unique_ptr<Base> create(size_t id) {
+            const std::vector<Factory>& table = factories();
+            if (id >= table.size() || table[id] == nullptr) {
+                throw std::runtime_error("Unknown type id!");
+            }
+            return table[id]();
+        }
+
+    private:
+        static std::vector<Factory>& factories() {
+            static std::vector<Factory> table;
+            return table;
+        }
+    };
+
+    template<typename Base, typename Derived>
+    std::unique_ptr<Base> createPolymorphic() {
+        return std::make_unique<Derived>();
+    }
+
+    template<typename T, typename = void>
+    struct isPolymorphicBin : std::false_type {};
+
+    template<typename T>
+    struct isPolymorphicBin<T, std::void_t<typename T::binPolymorphicRoot_>> : std::true_type {};
+
+    template<typename T>
+    constexpr bool isPolymorphicBin_v = isPolymorphicBin<T>::value;
+
+    template<typename T, typename = void>
+    struct hasBinMembers : std::false_type {};
+
+    template<typename T>
+    struct hasBinMembers<T, std::void_t<decltype(std::declval<const T&>().binMembers_())>> : std::true_type {};
+
+    template<typename T>
+    constexpr bool hasBinMembers_v = hasBinMembers<T>::value;
+
+    // Registered structs whose registered members are all raw values, listed in declaration order and covering the
+    // whole object, with no padding. Such a struct is written as one block of sizeof(T) bytes, which is the same
+    // byte sequence as writing the members one by one.
+    template<typename T, typename = void>
+    struct isRawStruct : std::false_type {};
+
+    template<typename T>
+    constexpr bool isRawValue_v = std::is_arithmetic_v<T> || std::is_enum_v<T> || isRawStruct<T>::value;
+
+    template<typename Members>
+    struct rawMembers : std::false_type {};
+
+    template<typename... Members>
+    struct rawMembers<std::tuple<Members...>> {
+        static constexpr bool value = ((std::is_lvalue_reference_v<Members> && isRawValue_v<std::remove_cvref_t<Members>>) && ...);
+        static constexpr size_t size = (sizeof(std::remove_cvref_t<Members>) + ... + 0);
+    };
+
+    // Whether the registered members of a value-initialized T sit at strictly increasing addresses, so they are
+    // distinct and registered in declaration order. Together with their sizes adding up to sizeof(T), this means
+    // they are contiguous and no member is left out.
+    template<typename T>
+    constexpr bool membersInLayoutOrder() {
+        T value{};
+        return std::apply([](const auto&... members) {
+            const void* addresses[] = {static_cast<const void*>(&members)...};
+            for (size_t i = 1; i < sizeof...(members); ++i) {
+                if (!std::less<const void*>()(addresses[i - 1], addresses[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }, static_cast<const T&>(value).binMembers_());
+    }
+
+    // False when the check cannot run at compile time (T is not a literal type), so such structs are written member by member.
+    // Only instantiated for default-constructible T (see isRawStruct), since the check builds a T.
+    template<typename T, typename = void>
+    struct hasLayoutOrder : std::false_type {};
+
+    template<typename T>
+    struct hasLayoutOrder<T, std::void_t<std::bool_constant<membersInLayoutOrder<T>()>>> : std::bool_constant<membersInLayoutOrder<T>()> {};
+
+    template<typename T>
+    struct hasRawMembers {
+        using Members = decltype(std::declval<const T&>().binMembers_());
+        static constexpr bool value = std::is_trivially_copyable_v<T> && rawMembers<Members>::value && rawMembers<Members>::size == sizeof(T);
+    };
+
+    template<typename T>
+    struct isRawStruct<T, std::enable_if_t<hasBinMembers_v<T>>>
+        : std::conjunction<hasRawMembers<T>, std::is_default_constructible<T>, hasLayoutOrder<T>> {};
+
+    template<typename T>
+    constexpr bool isRawStruct_v = isRawStruct<T>::value;
+
+    // Types whose contiguous arrays can be written with a single stream call.
+    // std::vector<bool> is not contiguous, so bool is excluded.
+    template<typename T>
+    constexpr bool isBulkCopyable_v = isRawValue_v<T> && !std::is_same_v<T, bool>;
+
+    template<typename T>
+    constexpr bool isBitPackable_v = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>;
+
+    // The integer type holding a bit-packable value, and its unsigned counterpart.
+    template<typename T>
+    using PackedInteger_t = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+
+    template<typename T>
+    using PackedUnsigned_t = std::make_unsigned_t<PackedInteger_t<T>>;
+
+    template<typename T>
+    constexpr bool isStreamVByteInteger_v = std::is_integral_v<T> && sizeof(T) == 4;
+
+    template<typename T>
+    constexpr bool isXorFloat_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    template<typename T>
+    constexpr bool isTimestamp_v = std::is_integral_v<T> && sizeof(T) == 8;
+
+    template<typename T>
+    struct isTimeSample : std::false_type {};
+
+    template<typename Time, typename Value>
+    struct isTimeSample<std::pair<Time, Value>> : std::bool_constant<isTimestamp_v<Time> && isXorFloat_v<Value>> {};
+
     template<typename T>
     void writeBinary(std::ostream& stream, const T& data) {
         stream.write(reinterpret_cast<const char*>(&data), sizeof(data));
@@ -33,33 +305,225 @@ namespace binSerialization {
         stream.read(reinterpret_cast<char*>(const_cast<std::remove_const_t<T>*>(&data)), sizeof(T));
     }
 
-    // Handling arithmetic types
     template<typename T>
-    typename std::enable_if_t<std::is_arithmetic_v<T>, void>
+    void writeBlock(std::ostream& stream, const T* data, size_t count) {
+        stream.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+
+    template<typename T>
+    void readBlock(std::istream& stream, T* data, size_t count) {
+        stream.read(reinterpret_cast<char*>(data), count * sizeof(T));
+    }
+
+    // LEB128 variable-length unsigned integers: 7 bits per byte, high bit set on all but the last byte.
+    inline void writeVarint(std::ostream& stream, uint64_t value) {
+        char buffer[10];
+        int length = 0;
+        while (value >= 0x80) {
+            buffer[length++] = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[length++] = static_cast<char>(value);
+        stream.write(buffer, length);
+    }
+
+    inline uint64_t readVarint(std::istream& stream) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = stream.get();
+            if (byte == std::char_traits<char>::eof()) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Invalid varint!");
+    }
+
+    // Element counts of plain sequences. SequenceWriter, which does not know the count up front,
+    // may write chunkedCount instead, followed by chunks of (count, elements) and a final count of 0.
+    constexpr size_t chunkedCount = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+    template<typename ReadChunk>
+    void readSequence(std::istream& stream, ReadChunk readChunk) {
+        size_t size = 0;
+        readBinary(stream, size);
+        if (size != chunkedCount) {
+            readChunk(size);
+            return;
+        }
+        while (true) {
+            size_t count = 0;
+            readBinary(stream, count);
+            if (!stream) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            if (count == 0) {
+                return;
+            }
+            readChunk(count);
+        }
+    }
+
+    // Handling arithmetic and enum types
+    template<typename T>
+    typename std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, void>
     serialize_(const T& value, std::ostream& stream) {
         writeBinary(stream, value);
     }
 
     template<typename T>
-    typename std::enable_if_t<std::is_arithmetic_v<T>, void>
+    typename std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, void>
     deserialize_(T& value, std::istream& stream) {
         readBinary(stream, value);
     }
 
+    // Handling std::vector<bool> and std::bitset: one byte per flag, or eight flags per byte with BitPacked
+    template<typename Bits>
+    void writeFlags(std::ostream& stream, const Bits& bits, size_t count) {
+        std::vector<uint8_t> bytes((count + 7) / 8);
+        for (size_t i = 0; i < count; ++i) {
+            bytes[i / 8] |= static_cast<uint8_t>(bits[i]) << (i % 8);
+        }
+        writeBlock(stream, bytes.data(), bytes.size());
+    }
+
+    template<typename Bits>
+    void readFlags(std::istream& stream, Bits& bits, size_t count) {
+        std::vector<uint8_t> bytes((count + 7) / 8);
+        readBlock(stream, bytes.data(), bytes.size());
+        for (size_t i = 0; i < count; ++i) {
+            bits[i] = (bytes[i / 8] >> (i % 8)) & 1;
+        }
+    }
+
+    inline void serialize_(const std::vector<bool>& vec, std::ostream& stream) {
+        size_t size = vec.size();
+        writeBinary(stream, size);
+        if (modeOf(stream) & BitPacked) {
+            writeFlags(stream, vec, size);
+            return;
+        }
+        for (bool flag : vec) {
+            writeBinary(stream, flag);
+        }
+    }
+
+    inline void deserialize_(std::vector<bool>& vec, std::istream& stream) {
+        vec.clear();
+        if (modeOf(stream) & BitPacked) {
+            size_t size;
+            readBinary(stream, size);
+            vec.assign(size, false);
+            readFlags(stream, vec, size);
+            return;
+        }
+        readSequence(stream, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                bool flag;
+                readBinary(stream, flag);
+                vec.push_back(flag);
+            }
+        });
+    }
+
+    template<size_t N>
+    void serialize_(const std::bitset<N>& bits, std::ostream& stream) {
+        if (modeOf(stream) & BitPacked) {
+            writeFlags(stream, bits, N);
+            return;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            writeBinary(stream, static_cast<bool>(bits[i]));
+        }
+    }
+
+    template<size_t N>
+    void deserialize_(std::bitset<N>& bits, std::istream& stream) {
+        if (modeOf(stream) & BitPacked) {
+            readFlags(stream, bits, N);
+            return;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            bool flag;
+            readBinary(stream, flag);
+            bits[i] = flag;
+        }
+    }
+
     // Handling std::string
-    void serialize_(const std::string& str, std::ostream& stream) {
+    // With SmallString the length is one byte, or 0xff followed by a varint for strings of 255 bytes and more.
+    void serializeString(const std::string& str, std::ostream& stream) {
         size_t length = str.size();
-        writeBinary(stream, length);
+        if (modeOf(stream) & SmallString) {
+            if (length < 0xff) {
+                stream.put(static_cast<char>(length));
+            } else {
+                stream.put(static_cast<char>(0xff));
+                writeVarint(stream, length);
+            }
+        } else {
+            writeBinary(stream, length);
+        }
         stream.write(str.data(), length);
     }
 
-    void deserialize_(std::string& str, std::istream& stream) {
+    void deserializeString(std::string& str, std::istream& stream) {
         size_t length;
+        if (modeOf(stream) & SmallString) {
+            int first = stream.get();
+            if (first == std::char_traits<char>::eof()) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            length = first < 0xff ? static_cast<size_t>(first) : readVarint(stream);
+            // resize allocates only when length exceeds the current capacity, so a reused string rarely
+            // does; the bytes are copied straight from the stream buffer.
+            str.resize(length);
+            if (stream.rdbuf()->sgetn(str.data(), length) != static_cast<std::streamsize>(length)) {
+                stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            }
+            return;
+        }
         readBinary(stream, length);
         str.resize(length);
         stream.read(&str[0], length);
     }
 
+    // With StringDictionary, every string starts with a varint: 0 means a new string follows
+    // and gets the next id, n > 0 repeats the string with id n - 1.
+    void serialize_(const std::string& str, std::ostream& stream) {
+        Context* context = contextOf(stream);
+        if (context && (context->mode & StringDictionary)) {
+            auto [it, inserted] = context->stringIds.try_emplace(str, context->stringIds.size());
+            if (!inserted) {
+                writeVarint(stream, it->second + 1);
+                return;
+            }
+            writeVarint(stream, 0);
+        }
+        serializeString(str, stream);
+    }
+
+    void deserialize_(std::string& str, std::istream& stream) {
+        Context* context = contextOf(stream);
+        if (context && (context->mode & StringDictionary)) {
+            uint64_t id = readVarint(stream);
+            if (id > context->strings.size()) {
+                throw std::runtime_error("Invalid string dictionary id!");
+            }
+            if (id != 0) {
+                str = context->strings[id - 1];
+                return;
+            }
+            deserializeString(str, stream);
+            context->strings.push_back(str);
+            return;
+        }
+        deserializeString(str, stream);
+    }
+
     // Some declaration
     template<typename Container>
     void serializeContainer(const Container& container, std::ostream& stream);
@@ -77,16 +541,163 @@ namespace binSerialization {
     template<typename T>
     typename std::enable_if_t<std::is_class_v<T>, void>
     deserialize_(T& obj, std::istream& stream);
+    template<typename T>
+    void serializeColumns(const std::vector<T>& rows, std::ostream& stream);
+    template<typename T>
+    void deserializeColumns(std::vector<T>& rows, std::istream& stream);
+    template<typename T>
+    void serializeStreamVByte(const std::vector<T>& vec, std::ostream& stream);
+    template<typename T>
+    void deserializeStreamVByte(std::vector<T>& vec, std::istream& stream);
+    template<typename T>
+    void serializeXorFloat(const std::vector<T>& vec, std::ostream& stream);
+    template<typename T>
+    void deserializeXorFloat(std::vector<T>& vec, std::istream& stream);
+    template<typename T>
+    void serializeDeltaOfDelta(const std::vector<T>& vec, std::ostream& stream);
+    template<typename T>
+    void deserializeDeltaOfDelta(std::vector<T>& vec, std::istream& stream);
+    template<typename Time, typename Value>
+    void serializeTimeSeries(const std::vector<std::pair<Time, Value>>& vec, std::ostream& stream);
+    template<typename Time, typename Value>
+    void deserializeTimeSeries(std::vector<std::pair<Time, Value>>& vec, std::istream& stream);
+    template<typename T>
+    void serializeBitPacked(const std::vector<T>& vec, std::ostream& stream);
+    template<typename T>
+    void deserializeBitPacked(std::vector<T>& vec, std::istream& stream);
+    template<typename T>
+    void serialize_(const std::unique_ptr<T>& ptr, std::ostream& stream);
+    template<typename T>
+    void deserialize_(std::unique_ptr<T>& ptr, std::istream& stream);
+    template<typename T, Mode M>
+    void serialize_(const WithMode<T, M>& member, std::ostream& stream);
+    template<typename T, Mode M>
+    void deserialize_(WithMode<T, M>& member, std::istream& stream);
+
 
+    // How a std::vector<T> is encoded under the given modes. Earlier entries win when several modes apply.
+    enum class VectorEncoding { Plain, Columnar, StreamVByte, XorFloat, DeltaOfDelta, TimeSeries, BitPacked };
+
+    template<typename T>
+    VectorEncoding vectorEncoding(Mode mode) {
+        if (hasBinMembers_v<T> && (mode & Columnar)) {
+            return VectorEncoding::Columnar;
+        }
+        if (isStreamVByteInteger_v<T> && (mode & StreamVByte)) {
+            return VectorEncoding::StreamVByte;
+        }
+        if (isXorFloat_v<T> && (mode & XorFloat)) {
+            return VectorEncoding::XorFloat;
+        }
+        if (isTimestamp_v<T> && (mode & DeltaOfDelta)) {
+            return VectorEncoding::DeltaOfDelta;
+        }
+        if (isTimeSample<T>::value && (mode & XorFloat)) {
+            return VectorEncoding::TimeSeries;
+        }
+        if ((isBitPackable_v<T> || std::is_same_v<T, bool>) && (mode & BitPacked)) {
+            return VectorEncoding::BitPacked;
+        }
+        return VectorEncoding::Plain;
+    }
 
     template<typename T>
     void serialize_(const std::vector<T>& vec, std::ostream& stream) {
-        serializeContainer(vec, stream);
+        VectorEncoding encoding = vectorEncoding<T>(modeOf(stream));
+        if constexpr (hasBinMembers_v<T>) {
+            if (encoding == VectorEncoding::Columnar) {
+                serializeColumns(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isStreamVByteInteger_v<T>) {
+            if (encoding == VectorEncoding::StreamVByte) {
+                serializeStreamVByte(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isXorFloat_v<T>) {
+            if (encoding == VectorEncoding::XorFloat) {
+                serializeXorFloat(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isTimestamp_v<T>) {
+            if (encoding == VectorEncoding::DeltaOfDelta) {
+                serializeDeltaOfDelta(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isTimeSample<T>::value) {
+            if (encoding == VectorEncoding::TimeSeries) {
+                serializeTimeSeries(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isBitPackable_v<T>) {
+            if (encoding == VectorEncoding::BitPacked) {
+                serializeBitPacked(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isBulkCopyable_v<T>) {
+            size_t size = vec.size();
+            writeBinary(stream, size);
+            writeBlock(stream, vec.data(), size);
+        } else {
+            serializeContainer(vec, stream);
+        }
     }
 
     template<typename T>
     void deserialize_(std::vector<T>& vec, std::istream& stream) {
-        deserializeContainer(vec, stream);
+        VectorEncoding encoding = vectorEncoding<T>(modeOf(stream));
+        if constexpr (hasBinMembers_v<T>) {
+            if (encoding == VectorEncoding::Columnar) {
+                deserializeColumns(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isStreamVByteInteger_v<T>) {
+            if (encoding == VectorEncoding::StreamVByte) {
+                deserializeStreamVByte(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isXorFloat_v<T>) {
+            if (encoding == VectorEncoding::XorFloat) {
+                deserializeXorFloat(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isTimestamp_v<T>) {
+            if (encoding == VectorEncoding::DeltaOfDelta) {
+                deserializeDeltaOfDelta(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isTimeSample<T>::value) {
+            if (encoding == VectorEncoding::TimeSeries) {
+                deserializeTimeSeries(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isBitPackable_v<T>) {
+            if (encoding == VectorEncoding::BitPacked) {
+                deserializeBitPacked(vec, stream);
+                return;
+            }
+        }
+        if constexpr (isBulkCopyable_v<T>) {
+            vec.clear();
+            readSequence(stream, [&](size_t count) {
+                size_t size = vec.size();
+                vec.resize(size + count);
+                readBlock(stream, vec.data() + size, count);
+            });
+        } else {
+            deserializeContainer(vec, stream);
+        }
     }
 
     template<typename T>
@@ -132,17 +743,98 @@ namespace binSerialization {
         deserialize_(pair.second, stream);
     }
 
+    // Handling std::unique_ptr
+    // Polymorphic types write their type id as a varint (0 for null) followed by the members of the dynamic type.
+    // Other types write a presence flag followed by the value. An existing object of the right type is reused.
+    template<typename T>
+    void serialize_(const std::unique_ptr<T>& ptr, std::ostream& stream) {
+        if constexpr (isPolymorphicBin_v<T>) {
+            size_t id = ptr ? ptr->binTypeId_() : 0;
+            if (ptr && id == 0) {
+                throw std::runtime_error("Type is not registered!");
+            }
+            writeVarint(stream, id);
+            if (ptr) {
+                ptr->serialize_(stream);
+            }
+        } else {
+            bool present = ptr != nullptr;
+            writeBinary(stream, present);
+            if (present) {
+                serialize_(*ptr, stream);
+            }
+        }
+    }
+
+    template<typename T>
+    void deserialize_(std::unique_ptr<T>& ptr, std::istream& stream) {
+        if constexpr (isPolymorphicBin_v<T>) {
+            using Root = typename T::binPolymorphicRoot_;
+            size_t id = readVarint(stream);
+            if (id == 0) {
+                ptr.reset();
+                return;
+            }
+            if (!ptr || ptr->binTypeId_() != id) {
+                std::unique_ptr<Root> object = PolymorphicRegistry<Root>::create(id);
+                if constexpr (std::is_same_v<T, Root>) {
+                    ptr = std::move(object);
+                } else {
+                    T* derived = dynamic_cast<T*>(object.get());
+                    if (derived == nullptr) {
+                        throw std::runtime_error("Type id does not match the pointer type!");
+                    }
+                    object.release();
+                    ptr.reset(derived);
+                }
+            }
+            ptr->deserialize_(stream);
+        } else {
+            bool present = false;
+            readBinary(stream, present);
+            if (!present) {
+                ptr.reset();
+                return;
+            }
+            if (!ptr) {
+                ptr = std::make_unique<T>();
+            }
+            deserialize_(*ptr, stream);
+        }
+    }
+
+    // Handling members registered with withMode
+    template<typename T, Mode M>
+    void serialize_(const WithMode<T, M>& member, std::ostream& stream) {
+        ModeGuard guard(stream, M);
+        serialize_(member.value, stream);
+    }
+
+    template<typename T, Mode M>
+    void deserialize_(WithMode<T, M>& member, std::istream& stream) {
+        ModeGuard guard(stream, M);
+        deserialize_(member.value, stream);
+    }
+
     // Handling User-defined class
     template<typename T>
     typename std::enable_if_t<std::is_class_v<T>, void>
     serialize_(const T& obj, std::ostream& stream) {
-        obj.serialize_(stream);
+        if constexpr (isRawStruct_v<T>) {
+            writeBinary(stream, obj);
+        } else {
+            obj.serialize_(stream);
+        }
     }
 
     template<typename T>
     typename std::enable_if_t<std::is_class_v<T>, void>
     deserialize_(T& obj, std::istream& stream) {
-        obj.deserialize_(stream);
+        if constexpr (isRawStruct_v<T>) {
+            readBinary(stream, obj);
+        } else {
+            obj.deserialize_(stream);
+        }
     }
 
     // Serialization and deserialization methods for containers
@@ -155,29 +847,525 @@ namespace binSerialization {
         }
     }
 
+    // ReuseCapacity methods: the existing elements are overwritten in place, so their strings and vectors keep
+    // their capacity, and map / set nodes are recycled through node handles. Only surplus elements are freed.
+    template<typename T>
+    void deserializeReusing(std::vector<T>& vec, std::istream& stream) {
+        size_t used = 0;
+        readSequence(stream, [&](size_t count) {
+            if (vec.size() < used + count) {
+                vec.resize(used + count);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                deserialize_(vec[used + i], stream);
+            }
+            used += count;
+        });
+        vec.resize(used);
+    }
+
+    template<typename T>
+    void deserializeReusing(std::list<T>& list, std::istream& stream) {
+        auto it = list.begin();
+        readSequence(stream, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i, ++it) {
+                if (it == list.end()) {
+                    it = list.emplace(list.end());
+                }
+                deserialize_(*it, stream);
+            }
+        });
+        list.erase(it, list.end());
+    }
+
+    template<typename T>
+    void deserializeReusing(std::set<T>& set, std::istream& stream) {
+        std::set<T> nodes;
+        nodes.swap(set);
+        readSequence(stream, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (nodes.empty()) {
+                    T element;
+                    deserialize_(element, stream);
+                    set.insert(set.end(), std::move(element));
+                    continue;
+                }
+                auto node = nodes.extract(nodes.begin());
+                deserialize_(node.value(), stream);
+                set.insert(set.end(), std::move(node));
+            }
+        });
+    }
+
+    template<typename Key, typename Value>
+    void deserializeReusing(std::map<Key, Value>& map, std::istream& stream) {
+        std::map<Key, Value> nodes;
+        nodes.swap(map);
+        readSequence(stream, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (nodes.empty()) {
+                    std::pair<Key, Value> element;
+                    deserialize_(element, stream);
+                    map.insert(map.end(), std::move(element));
+                    continue;
+                }
+                auto node = nodes.extract(nodes.begin());
+                deserialize_(node.key(), stream);
+                deserialize_(node.mapped(), stream);
+                map.insert(map.end(), std::move(node));
+            }
+        });
+    }
+
     template<typename Container>
     void deserializeContainer(Container& container, std::istream& stream) {
-        size_t size;
-        readBinary(stream, size);
-        container.clear();
-        for (size_t i = 0; i < size; ++i) {
-            typename Container::value_type element;
-            deserialize_(element, stream);
-            container.insert(container.end(), std::move(element));
+        if (modeOf(stream) & ReuseCapacity) {
+            deserializeReusing(container, stream);
+            return;
         }
+        container.clear();
+        readSequence(stream, [&](size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                typename Container::value_type element;
+                deserialize_(element, stream);
+                container.insert(container.end(), std::move(element));
+            }
+        });
     }
 
     // special case for std::map, because key is CONST.
     template<typename Key, typename Value>
     void deserializeContainer(std::map<Key, Value>& map, std::istream& stream) { 
+        if (modeOf(stream) & ReuseCapacity) {
+            deserializeReusing(map, stream);
+            return;
+        }
+        map.clear();
+        readSequence(stream, [&](size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                std::pair<Key, Value> element;
+                deserialize_(element, stream);
+                map.insert(std::move(element));
+            }
+        });
+    }
+
+    // Columnar (struct-of-arrays) methods for vectors of registered structs.
+    // Each registered member becomes one column: arithmetic members are written as a single block,
+    // strings as a block of end offsets followed by the concatenated bytes, anything else element by element.
+    template<size_t Index, typename T>
+    void serializeColumn(const std::vector<T>& rows, std::ostream& stream) {
+        using Member = std::remove_cvref_t<std::tuple_element_t<Index, decltype(std::declval<const T&>().binMembers_())>>;
+        if constexpr (isBulkCopyable_v<Member>) {
+            std::vector<Member> column;
+            column.reserve(rows.size());
+            for (const auto& row : rows) {
+                column.push_back(std::get<Index>(row.binMembers_()));
+            }
+            writeBlock(stream, column.data(), column.size());
+        } else if constexpr (std::is_same_v<Member, std::string>) {
+            if (modeOf(stream) & StringDictionary) {
+                for (const auto& row : rows) {
+                    serialize_(std::get<Index>(row.binMembers_()), stream);
+                }
+                return;
+            }
+            std::vector<size_t> offsets;
+            offsets.reserve(rows.size());
+            std::string bytes;
+            for (const auto& row : rows) {
+                bytes += std::get<Index>(row.binMembers_());
+                offsets.push_back(bytes.size());
+            }
+            writeBlock(stream, offsets.data(), offsets.size());
+            stream.write(bytes.data(), bytes.size());
+        } else {
+            for (const auto& row : rows) {
+                serialize_(std::get<Index>(row.binMembers_()), stream);
+            }
+        }
+    }
+
+    template<size_t Index, typename T>
+    void deserializeColumn(std::vector<T>& rows, std::istream& stream) {
+        using Member = std::remove_cvref_t<std::tuple_element_t<Index, decltype(std::declval<T&>().binMembers_())>>;
+        if constexpr (isBulkCopyable_v<Member>) {
+            std::vector<Member> column(rows.size());
+            readBlock(stream, column.data(), column.size());
+            for (size_t i = 0; i < rows.size(); ++i) {
+                std::get<Index>(rows[i].binMembers_()) = column[i];
+            }
+        } else if constexpr (std::is_same_v<Member, std::string>) {
+            if (modeOf(stream) & StringDictionary) {
+                for (auto& row : rows) {
+                    deserialize_(std::get<Index>(row.binMembers_()), stream);
+                }
+                return;
+            }
+            std::vector<size_t> offsets(rows.size());
+            readBlock(stream, offsets.data(), offsets.size());
+            std::string bytes(offsets.empty() ? 0 : offsets.back(), '\0');
+            stream.read(bytes.data(), bytes.size());
+            size_t begin = 0;
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (offsets[i] < begin || offsets[i] > bytes.size()) {
+                    throw std::runtime_error("Invalid string column!");
+                }
+                std::get<Index>(rows[i].binMembers_()).assign(bytes, begin, offsets[i] - begin);
+                begin = offsets[i];
+            }
+        } else {
+            for (auto& row : rows) {
+                // withMode members are held by value, so take them from a named tuple to get an lvalue.
+                auto members = row.binMembers_();
+                deserialize_(std::get<Index>(members), stream);
+            }
+        }
+    }
+
+    template<typename T>
+    void serializeColumns(const std::vector<T>& rows, std::ostream& stream) {
+        size_t size = rows.size();
+        writeBinary(stream, size);
+        constexpr size_t columns = std::tuple_size_v<decltype(std::declval<const T&>().binMembers_())>;
+        [&]<size_t... Index>(std::index_sequence<Index...>) {
+            (serializeColumn<Index>(rows, stream), ...);
+        }(std::make_index_sequence<columns>{});
+    }
+
+    template<typename T>
+    void deserializeColumns(std::vector<T>& rows, std::istream& stream) {
         size_t size;
         readBinary(stream, size);
-        map.clear();
+        if (!(modeOf(stream) & ReuseCapacity)) {
+            rows.clear();
+        }
+        rows.resize(size);
+        constexpr size_t columns = std::tuple_size_v<decltype(std::declval<T&>().binMembers_())>;
+        [&]<size_t... Index>(std::index_sequence<Index...>) {
+            (deserializeColumn<Index>(rows, stream), ...);
+        }(std::make_index_sequence<columns>{});
+    }
+
+    // Stream VByte methods: element count, data length, control bytes, then data bytes.
+    template<typename T>
+    void serializeStreamVByte(const std::vector<T>& vec, std::ostream& stream) {
+        size_t size = vec.size();
+        size_t controlLength = streamVByteControlLength(size);
+        std::vector<uint8_t> buffer(controlLength + 4 * size);
+        size_t dataLength = streamVByteEncode(vec.data(), size, buffer.data(), buffer.data() + controlLength);
+        writeBinary(stream, size);
+        writeBinary(stream, dataLength);
+        writeBlock(stream, buffer.data(), controlLength + dataLength);
+    }
+
+    template<typename T>
+    void deserializeStreamVByte(std::vector<T>& vec, std::istream& stream) {
+        size_t size, dataLength;
+        readBinary(stream, size);
+        readBinary(stream, dataLength);
+        size_t controlLength = streamVByteControlLength(size);
+        if (dataLength > 4 * size) {
+            throw std::runtime_error("Invalid Stream VByte data!");
+        }
+        std::vector<uint8_t> buffer(controlLength + dataLength + streamVByteDecodePadding);
+        readBlock(stream, buffer.data(), controlLength + dataLength);
+        if (streamVByteDataLength(buffer.data(), size) != dataLength) {
+            throw std::runtime_error("Invalid Stream VByte data!");
+        }
+        vec.resize(size);
+        streamVByteDecode(buffer.data(), buffer.data() + controlLength, size, vec.data());
+    }
+
+    // Bit streams are written as their byte length followed by the bytes.
+    inline void writeBits(std::ostream& stream, BitWriter& writer) {
+        std::vector<uint8_t>& bytes = writer.finish();
+        size_t length = bytes.size();
+        writeBinary(stream, length);
+        writeBlock(stream, bytes.data(), length);
+    }
+
+    inline std::vector<uint8_t> readBits(std::istream& stream) {
+        size_t length;
+        readBinary(stream, length);
+        std::vector<uint8_t> bytes(length);
+        readBlock(stream, bytes.data(), length);
+        if (!stream) {
+            throw std::runtime_error("Unexpected end of file!");
+        }
+        return bytes;
+    }
+
+    // Gorilla methods: element count followed by the bit stream(s).
+    template<typename T>
+    void serializeXorFloat(const std::vector<T>& vec, std::ostream& stream) {
+        size_t size = vec.size();
+        writeBinary(stream, size);
+        BitWriter writer;
+        gorillaEncode(vec.data(), size, writer);
+        writeBits(stream, writer);
+    }
+
+    template<typename T>
+    void deserializeXorFloat(std::vector<T>& vec, std::istream& stream) {
+        size_t size;
+        readBinary(stream, size);
+        std::vector<uint8_t> bytes = readBits(stream);
+        BitReader reader(bytes.data(), bytes.size());
+        vec.resize(size);
+        gorillaDecode(reader, size, vec.data());
+    }
+
+    template<typename T>
+    void serializeDeltaOfDelta(const std::vector<T>& vec, std::ostream& stream) {
+        size_t size = vec.size();
+        writeBinary(stream, size);
+        BitWriter writer;
+        deltaOfDeltaEncode(vec.data(), size, writer);
+        writeBits(stream, writer);
+    }
+
+    template<typename T>
+    void deserializeDeltaOfDelta(std::vector<T>& vec, std::istream& stream) {
+        size_t size;
+        readBinary(stream, size);
+        std::vector<uint8_t> bytes = readBits(stream);
+        BitReader reader(bytes.data(), bytes.size());
+        vec.resize(size);
+        deltaOfDeltaDecode(reader, size, vec.data());
+    }
+
+    // (timestamp, value) pairs: timestamps with delta-of-delta, values with XOR, as two separate bit streams.
+    template<typename Time, typename Value>
+    void serializeTimeSeries(const std::vector<std::pair<Time, Value>>& vec, std::ostream& stream) {
+        size_t size = vec.size();
+        std::vector<Time> times;
+        std::vector<Value> values;
+        times.reserve(size);
+        values.reserve(size);
+        for (const auto& sample : vec) {
+            times.push_back(sample.first);
+            values.push_back(sample.second);
+        }
+        writeBinary(stream, size);
+        BitWriter timeWriter, valueWriter;
+        deltaOfDeltaEncode(times.data(), size, timeWriter);
+        gorillaEncode(values.data(), size, valueWriter);
+        writeBits(stream, timeWriter);
+        writeBits(stream, valueWriter);
+    }
+
+    template<typename Time, typename Value>
+    void deserializeTimeSeries(std::vector<std::pair<Time, Value>>& vec, std::istream& stream) {
+        size_t size;
+        readBinary(stream, size);
+        std::vector<uint8_t> timeBytes = readBits(stream);
+        std::vector<uint8_t> valueBytes = readBits(stream);
+        BitReader timeReader(timeBytes.data(), timeBytes.size()), valueReader(valueBytes.data(), valueBytes.size());
+        std::vector<Time> times(size);
+        std::vector<Value> values(size);
+        deltaOfDeltaDecode(timeReader, size, times.data());
+        gorillaDecode(valueReader, size, values.data());
+        vec.resize(size);
         for (size_t i = 0; i < size; ++i) {
-            std::pair<Key, Value> element;
-            deserialize_(element, stream);
-            map.insert(std::move(element));
+            vec[i] = {times[i], values[i]};
+        }
+    }
+
+    // Bit-packing methods: element count, then blocks of bitPackingBlockSize values,
+    // each one its minimum, its bit width (one byte) and the packed offsets from the minimum.
+    template<typename T>
+    void serializeBitPacked(const std::vector<T>& vec, std::ostream& stream) {
+        using Integer = PackedInteger_t<T>;
+        using Unsigned = PackedUnsigned_t<T>;
+        size_t size = vec.size();
+        writeBinary(stream, size);
+        std::array<uint64_t, bitPackingBlockSize> offsets;
+        std::vector<uint8_t> packed(packedLength(bitPackingBlockSize, 64));
+        for (size_t begin = 0; begin < size; begin += bitPackingBlockSize) {
+            size_t count = std::min(bitPackingBlockSize, size - begin);
+            Integer minimum = static_cast<Integer>(vec[begin]);
+            for (size_t i = 1; i < count; ++i) {
+                minimum = std::min(minimum, static_cast<Integer>(vec[begin + i]));
+            }
+            for (size_t i = 0; i < count; ++i) {
+                offsets[i] = static_cast<Unsigned>(static_cast<Unsigned>(vec[begin + i]) - static_cast<Unsigned>(minimum));
+            }
+            uint8_t width = static_cast<uint8_t>(bitWidth(offsets.data(), count));
+            packBits(offsets.data(), count, width, packed.data());
+            writeBinary(stream, static_cast<Unsigned>(minimum));
+            writeBinary(stream, width);
+            writeBlock(stream, packed.data(), packedLength(count, width));
+        }
+    }
+
+    template<typename T>
+    void deserializeBitPacked(std::vector<T>& vec, std::istream& stream) {
+        using Integer = PackedInteger_t<T>;
+        using Unsigned = PackedUnsigned_t<T>;
+        size_t size;
+        readBinary(stream, size);
+        vec.resize(size);
+        std::array<uint64_t, bitPackingBlockSize> offsets;
+        std::vector<uint8_t> packed(packedLength(bitPackingBlockSize, 64) + bitPackingPadding);
+        for (size_t begin = 0; begin < size; begin += bitPackingBlockSize) {
+            size_t count = std::min(bitPackingBlockSize, size - begin);
+            Unsigned minimum;
+            uint8_t width;
+            readBinary(stream, minimum);
+            readBinary(stream, width);
+            if (width > sizeof(Unsigned) * 8) {
+                throw std::runtime_error("Invalid bit width!");
+            }
+            readBlock(stream, packed.data(), packedLength(count, width));
+            unpackBits(packed.data(), count, width, offsets.data());
+            for (size_t i = 0; i < count; ++i) {
+                vec[begin + i] = static_cast<T>(static_cast<Integer>(static_cast<Unsigned>(minimum + offsets[i])));
+            }
+        }
+    }
+
+    // Structural type fingerprints: an FNV-1a hash over the shape of a type, computed at compile time.
+    // Arithmetic types contribute their size and kind, containers their kind and element types,
+    // registered structs the types of their registered members in order.
+    enum class FingerprintTag : uint64_t {
+        Arithmetic = 1, Enum, String, Vector, List, Map, Set, Pair, Bitset, Struct, WithMode, Mode, Pointer
+    };
+
+    constexpr uint64_t fingerprintMix(uint64_t hash, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ull;
         }
+        return hash;
+    }
+
+    template<typename... Values>
+    constexpr uint64_t fingerprintOf(FingerprintTag tag, Values... values) {
+        uint64_t hash = fingerprintMix(14695981039346656037ull, static_cast<uint64_t>(tag));
+        ((hash = fingerprintMix(hash, static_cast<uint64_t>(values))), ...);
+        return hash;
+    }
+
+    template<typename T>
+    struct TypeFingerprint {
+        static constexpr uint64_t compute() {
+            if constexpr (std::is_enum_v<T>) {
+                return fingerprintOf(FingerprintTag::Enum, TypeFingerprint<std::underlying_type_t<T>>::value);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return fingerprintOf(FingerprintTag::Arithmetic, sizeof(T), std::is_floating_point_v<T>, std::is_signed_v<T>, std::is_same_v<T, bool>);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return fingerprintOf(FingerprintTag::String);
+            } else if constexpr (hasBinMembers_v<T>) {
+                using Members = decltype(std::declval<const T&>().binMembers_());
+                return [&]<size_t... Index>(std::index_sequence<Index...>) {
+                    return fingerprintOf(FingerprintTag::Struct, sizeof...(Index),
+                        TypeFingerprint<std::remove_cvref_t<std::tuple_element_t<Index, Members>>>::value...);
+                }(std::make_index_sequence<std::tuple_size_v<Members>>{});
+            } else {
+                return fingerprintOf(FingerprintTag::Struct, sizeof(T));
+            }
+        }
+        static constexpr uint64_t value = compute();
+    };
+
+    template<typename T>
+    struct TypeFingerprint<std::vector<T>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Vector, TypeFingerprint<T>::value);
+    };
+
+    template<typename T>
+    struct TypeFingerprint<std::list<T>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::List, TypeFingerprint<T>::value);
+    };
+
+    template<typename Key, typename Value>
+    struct TypeFingerprint<std::map<Key, Value>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Map, TypeFingerprint<Key>::value, TypeFingerprint<Value>::value);
+    };
+
+    template<typename T>
+    struct TypeFingerprint<std::set<T>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Set, TypeFingerprint<T>::value);
+    };
+
+    template<typename T1, typename T2>
+    struct TypeFingerprint<std::pair<T1, T2>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Pair, TypeFingerprint<T1>::value, TypeFingerprint<T2>::value);
+    };
+
+    template<size_t N>
+    struct TypeFingerprint<std::bitset<N>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Bitset, N);
+    };
+
+    template<typename T>
+    struct TypeFingerprint<std::unique_ptr<T>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::Pointer, TypeFingerprint<T>::value);
+    };
+
+    template<typename T, Mode M>
+    struct TypeFingerprint<WithMode<T, M>> {
+        static constexpr uint64_t value = fingerprintOf(FingerprintTag::WithMode, M, TypeFingerprint<std::remove_const_t<T>>::value);
+    };
+
+    template<typename T>
+    constexpr uint64_t typeFingerprint_v = TypeFingerprint<T>::value;
+
+    // The header written with TypeHeader: the type fingerprint combined with the modes used for the file.
+    template<typename T>
+    constexpr uint64_t fileFingerprint(Mode mode) {
+        // ReuseCapacity only changes how a file is read, not what is written.
+        mode = static_cast<Mode>(mode & ~ReuseCapacity);
+        return fingerprintMix(typeFingerprint_v<T>, fingerprintOf(FingerprintTag::Mode, mode));
+    }
+
+    template<typename T>
+    void writeHeader(std::ostream& stream, Mode mode) {
+        if (mode & TypeHeader) {
+            writeBinary(stream, fileFingerprint<T>(mode));
+        }
+    }
+
+    template<typename T>
+    void checkHeader(std::istream& stream, Mode mode) {
+        if (mode & TypeHeader) {
+            uint64_t fingerprint = 0;
+            readBinary(stream, fingerprint);
+            if (fingerprint != fileFingerprint<T>(mode)) {
+                throw std::runtime_error("File does not match the type!");
+            }
+        }
+    }
+
+    /*
+    * Serialize the value to an output stream.
+    * @param
+    *     value: the value to be serialized.
+    *     stream: the stream to write the serialized data to.
+    *     mode: the encoding modes to use (see Mode).
+    */
+    template<typename T>
+    void serialize(const T& obj, std::ostream& stream, Mode mode = Default) {
+        writeHeader<T>(stream, mode);
+        Context context{mode};
+        ContextGuard guard(stream, context);
+        serialize_(obj, stream);
+    }
+
+    /*
+    * Deserialize the value from an input stream.
+    * @param
+    *    value: the value to be deserialized.
+    *    stream: the stream to read the serialized data from.
+    *    mode: the encoding modes the data was written with.
+    */
+    template<typename T>
+    void deserialize(T& obj, std::istream& stream, Mode mode = Default) {
+        checkHeader<T>(stream, mode);
+        Context context{mode};
+        ContextGuard guard(stream, context);
+        deserialize_(obj, stream);
     }
 
     /*
@@ -185,14 +1373,15 @@ namespace binSerialization {
     * @param 
     *     value: the value to be serialized.
     *     filename: the name of the file to store the serialized data.
+    *     mode: the encoding modes to use (see Mode).
     */
     template<typename T>
-    void serialize(const T& obj, const std::string& filename) {
+    void serialize(const T& obj, const std::string& filename, Mode mode = Default) {
         std::ofstream outStream(filename, std::ios::binary);
         if (!outStream) {
             throw std::runtime_error("File cannot be created!");
         }
-        serialize_(obj, outStream);
+        serialize(obj, outStream, mode);
     }
 
     /*
@@ -200,16 +1389,731 @@ namespace binSerialization {
     * @param
     *    value: the value to be deserialized.
     *   filename: the name of the file to read the serialized data.
+    *   mode: the encoding modes the file was written with.
     */
     template<typename T>
-    void deserialize(T& obj, const std::string& filename) {
+    void deserialize(T& obj, const std::string& filename, Mode mode = Default) {
         std::ifstream inStream(filename, std::ios::binary);
         if (!inStream) {
             throw std::runtime_error("File not found!");
         }
-        deserialize_(obj, inStream);
+        deserialize(obj, inStream, mode);
+    }
+
+    // Delta serialization: only the differences between a value and a baseline are written.
+    // Maps and sets are compared by key, vectors chunk by chunk; values are compared with operator==.
+
+    constexpr size_t deltaChunkSize = 64;
+
+    // Any other type: a flag, followed by the whole value if it changed.
+    template<typename T>
+    void serializeDelta_(const T& current, const T& baseline, std::ostream& stream) {
+        bool changed = !(current == baseline);
+        writeBinary(stream, changed);
+        if (changed) {
+            serialize_(current, stream);
+        }
+    }
+
+    template<typename T>
+    void applyDelta_(T& state, std::istream& stream) {
+        bool changed = false;
+        readBinary(stream, changed);
+        if (changed) {
+            deserialize_(state, stream);
+        }
+    }
+
+    // std::map: the deleted keys, then the inserted or updated pairs.
+    template<typename Key, typename Value>
+    void serializeDelta_(const std::map<Key, Value>& current, const std::map<Key, Value>& baseline, std::ostream& stream) {
+        std::vector<const Key*> deleted;
+        std::vector<const std::pair<const Key, Value>*> upserted;
+        auto it = current.begin();
+        auto base = baseline.begin();
+        while (it != current.end() || base != baseline.end()) {
+            if (base == baseline.end() || (it != current.end() && current.key_comp()(it->first, base->first))) {
+                upserted.push_back(&*it++);
+            } else if (it == current.end() || current.key_comp()(base->first, it->first)) {
+                deleted.push_back(&base++->first);
+            } else {
+                if (!(it->second == base->second)) {
+                    upserted.push_back(&*it);
+                }
+                ++it;
+                ++base;
+            }
+        }
+        writeVarint(stream, deleted.size());
+        for (const Key* key : deleted) {
+            serialize_(*key, stream);
+        }
+        writeVarint(stream, upserted.size());
+        for (const auto* element : upserted) {
+            serialize_(element->first, stream);
+            serialize_(element->second, stream);
+        }
+    }
+
+    template<typename Key, typename Value>
+    void applyDelta_(std::map<Key, Value>& state, std::istream& stream) {
+        uint64_t deleted = readVarint(stream);
+        for (uint64_t i = 0; i < deleted; ++i) {
+            Key key;
+            deserialize_(key, stream);
+            state.erase(key);
+        }
+        uint64_t upserted = readVarint(stream);
+        for (uint64_t i = 0; i < upserted; ++i) {
+            std::pair<Key, Value> element;
+            deserialize_(element, stream);
+            state.insert_or_assign(std::move(element.first), std::move(element.second));
+        }
+    }
+
+    // std::set: the deleted elements, then the inserted ones.
+    template<typename T>
+    void serializeDelta_(const std::set<T>& current, const std::set<T>& baseline, std::ostream& stream) {
+        std::vector<const T*> deleted, inserted;
+        auto it = current.begin();
+        auto base = baseline.begin();
+        while (it != current.end() || base != baseline.end()) {
+            if (base == baseline.end() || (it != current.end() && current.key_comp()(*it, *base))) {
+                inserted.push_back(&*it++);
+            } else if (it == current.end() || current.key_comp()(*base, *it)) {
+                deleted.push_back(&*base++);
+            } else {
+                ++it;
+                ++base;
+            }
+        }
+        writeVarint(stream, deleted.size());
+        for (const T* element : deleted) {
+            serialize_(*element, stream);
+        }
+        writeVarint(stream, inserted.size());
+        for (const T* element : inserted) {
+            serialize_(*element, stream);
+        }
+    }
+
+    template<typename T>
+    void applyDelta_(std::set<T>& state, std::istream& stream) {
+        uint64_t deleted = readVarint(stream);
+        for (uint64_t i = 0; i < deleted; ++i) {
+            T element;
+            deserialize_(element, stream);
+            state.erase(element);
+        }
+        uint64_t inserted = readVarint(stream);
+        for (uint64_t i = 0; i < inserted; ++i) {
+            T element;
+            deserialize_(element, stream);
+            state.insert(std::move(element));
+        }
+    }
+
+    // std::vector: the new size, then every chunk of deltaChunkSize elements that differs from the baseline.
+    template<typename T>
+    void serializeDelta_(const std::vector<T>& current, const std::vector<T>& baseline, std::ostream& stream) {
+        std::vector<size_t> changed;
+        for (size_t begin = 0; begin < current.size(); begin += deltaChunkSize) {
+            size_t end = std::min(begin + deltaChunkSize, current.size());
+            bool same = end <= baseline.size();
+            for (size_t i = begin; same && i < end; ++i) {
+                same = current[i] == baseline[i];
+            }
+            if (!same) {
+                changed.push_back(begin / deltaChunkSize);
+            }
+        }
+        writeVarint(stream, current.size());
+        writeVarint(stream, changed.size());
+        for (size_t chunk : changed) {
+            writeVarint(stream, chunk);
+            size_t begin = chunk * deltaChunkSize;
+            size_t end = std::min(begin + deltaChunkSize, current.size());
+            for (size_t i = begin; i < end; ++i) {
+                serialize_(static_cast<const T&>(current[i]), stream);
+            }
+        }
+    }
+
+    template<typename T>
+    void applyDelta_(std::vector<T>& state, std::istream& stream) {
+        uint64_t size = readVarint(stream);
+        uint64_t changed = readVarint(stream);
+        state.resize(size);
+        for (uint64_t c = 0; c < changed; ++c) {
+            uint64_t chunk = readVarint(stream);
+            if (chunk * deltaChunkSize >= size) {
+                throw std::runtime_error("Invalid delta chunk!");
+            }
+            size_t begin = chunk * deltaChunkSize;
+            size_t end = std::min<size_t>(begin + deltaChunkSize, size);
+            for (size_t i = begin; i < end; ++i) {
+                T element;
+                deserialize_(element, stream);
+                state[i] = std::move(element);
+            }
+        }
+    }
+
+    /*
+    * Serialize the difference between a value and a baseline to the file with the given filename.
+    * @param
+    *     current: the value to be serialized.
+    *     baseline: the value the delta is relative to.
+    *     filename: the name of the file to store the delta.
+    *     mode: the encoding modes to use (see Mode).
+    */
+    template<typename T>
+    void serializeDelta(const T& current, const T& baseline, const std::string& filename, Mode mode = Default) {
+        std::ofstream outStream(filename, std::ios::binary);
+        if (!outStream) {
+            throw std::runtime_error("File cannot be created!");
+        }
+        writeHeader<T>(outStream, mode);
+        Context context{mode};
+        ContextGuard guard(outStream, context);
+        serializeDelta_(current, baseline, outStream);
     }
 
+    /*
+    * Apply a delta written by serializeDelta, turning the baseline into the new value.
+    * @param
+    *    state: the baseline, updated in place.
+    *    filename: the name of the file to read the delta from.
+    *    mode: the encoding modes the delta was written with.
+    */
+    template<typename T>
+    void applyDelta(T& state, const std::string& filename, Mode mode = Default) {
+        std::ifstream inStream(filename, std::ios::binary);
+        if (!inStream) {
+            throw std::runtime_error("File not found!");
+        }
+        checkHeader<T>(inStream, mode);
+        Context context{mode};
+        ContextGuard guard(inStream, context);
+        applyDelta_(state, inStream);
+    }
+
+    // A read-only stream buffer over bytes in memory.
+    class MemoryBuffer : public std::streambuf {
+    public:
+        MemoryBuffer(const char* data, size_t size) {
+            char* begin = const_cast<char*>(data);
+            setg(begin, begin, begin + size);
+        }
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override {
+            if (!(which & std::ios_base::in)) {
+                return pos_type(off_type(-1));
+            }
+            char* base = direction == std::ios_base::beg ? eback() : direction == std::ios_base::cur ? gptr() : egptr();
+            if (offset < eback() - base || offset > egptr() - base) {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), base + offset, egptr());
+            return pos_type(gptr() - eback());
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode which) override {
+            return seekoff(off_type(position), std::ios_base::beg, which);
+        }
+    };
+
+    // Compile-time encoding: serializedSize and encodeInto produce the Default format (no header) in a constant
+    // expression, so embed<Make>() can bake a value into the read-only data of the executable.
+    // Supported are arithmetic and enum types, raw structs, std::string, std::vector (except std::vector<bool>),
+    // std::pair and registered structs made of these; the node-based containers are not usable in constant expressions.
+    template<typename T>
+    struct isPair : std::false_type {};
+
+    template<typename T1, typename T2>
+    struct isPair<std::pair<T1, T2>> : std::true_type {};
+
+    template<typename T>
+    constexpr size_t serializedSize(const T& value) {
+        if constexpr (isRawValue_v<T>) {
+            return sizeof(T);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return sizeof(size_t) + value.size();
+        } else if constexpr (isPair<T>::value) {
+            return serializedSize(value.first) + serializedSize(value.second);
+        } else if constexpr (hasBinMembers_v<T>) {
+            return std::apply([](const auto&... members) {
+                return (serializedSize(members) + ... + size_t(0));
+            }, value.binMembers_());
+        } else if constexpr (requires { value.begin(); value.size(); } && !std::is_same_v<T, std::vector<bool>>) {
+            size_t size = sizeof(size_t);
+            for (const auto& element : value) {
+                size += serializedSize(element);
+            }
+            return size;
+        } else {
+            static_assert(sizeof(T) == 0, "The type cannot be encoded at compile time");
+        }
+    }
+
+    template<typename T, size_t N>
+    constexpr void encodeInto(const T& value, std::array<std::byte, N>& blob, size_t& position) {
+        if constexpr (isRawValue_v<T>) {
+            for (std::byte byte : std::bit_cast<std::array<std::byte, sizeof(T)>>(value)) {
+                blob[position++] = byte;
+            }
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            encodeInto(value.size(), blob, position);
+            for (char c : value) {
+                blob[position++] = static_cast<std::byte>(c);
+            }
+        } else if constexpr (isPair<T>::value) {
+            encodeInto(value.first, blob, position);
+            encodeInto(value.second, blob, position);
+        } else if constexpr (hasBinMembers_v<T>) {
+            std::apply([&](const auto&... members) {
+                (encodeInto(members, blob, position), ...);
+            }, value.binMembers_());
+        } else {
+            static_assert(!std::is_same_v<T, std::vector<bool>>, "The type cannot be encoded at compile time");
+            encodeInto(value.size(), blob, position);
+            for (const auto& element : value) {
+                encodeInto(element, blob, position);
+            }
+        }
+    }
+
+    /*
+    * Encode the value returned by Make at compile time.
+    * e.g. static constexpr auto table = embed<[] { return std::vector<int>{2, 3, 5, 7}; }>();
+    * @return the encoded bytes, as std::array<std::byte, serializedSize(Make())>.
+    */
+    template<auto Make>
+    constexpr auto embed() {
+        constexpr size_t size = serializedSize(Make());
+        std::array<std::byte, size> blob{};
+        size_t position = 0;
+        encodeInto(Make(), blob, position);
+        return blob;
+    }
+
+    /*
+    * Deserialize the value from bytes in memory, e.g. a blob produced by embed.
+    * @param
+    *    value: the value to be deserialized.
+    *    blob: the serialized bytes.
+    *    mode: the encoding modes the bytes were written with.
+    */
+    template<typename T>
+    void deserialize(T& obj, std::span<const std::byte> blob, Mode mode = Default) {
+        MemoryBuffer buffer(reinterpret_cast<const char*>(blob.data()), blob.size());
+        std::istream stream(&buffer);
+        deserialize(obj, stream, mode);
+        if (!stream) {
+            throw std::runtime_error("Unexpected end of file!");
+        }
+    }
+
+    // Zero-copy views of a blob holding a std::string, or a std::vector of raw values, in the Default format.
+    inline size_t blobCount(std::span<const std::byte> blob, size_t elementSize) {
+        size_t count = 0;
+        if (blob.size() < sizeof(count)) {
+            throw std::runtime_error("Unexpected end of file!");
+        }
+        std::memcpy(&count, blob.data(), sizeof(count));
+        if (count > (blob.size() - sizeof(count)) / elementSize) {
+            throw std::runtime_error("Unexpected end of file!");
+        }
+        return count;
+    }
+
+    inline std::string_view viewString(std::span<const std::byte> blob) {
+        size_t length = blobCount(blob, 1);
+        return {reinterpret_cast<const char*>(blob.data() + sizeof(size_t)), length};
+    }
+
+    // The blob must be aligned for T, e.g. alignas(8) static constexpr auto table = embed<...>();
+    template<typename T>
+    std::span<const T> viewVector(std::span<const std::byte> blob) {
+        static_assert(isBulkCopyable_v<T>, "Only vectors of raw values can be viewed in place");
+        size_t count = blobCount(blob, sizeof(T));
+        const std::byte* data = blob.data() + sizeof(size_t);
+        if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+            throw std::runtime_error("Blob is not aligned for the element type!");
+        }
+        return {reinterpret_cast<const T*>(data), count};
+    }
+
+    /*
+    * Writes many named objects into one file: a table of contents (name, offset, length of each entry)
+    * followed by the entries. Every entry is encoded on its own, so it can be loaded without the others.
+    */
+    class BundleWriter {
+    public:
+        explicit BundleWriter(Mode mode = Default) : mode_(mode) {}
+
+        template<typename T>
+        BundleWriter& add(const std::string& name, const T& obj) {
+            for (const auto& entry : entries_) {
+                if (entry.name == name) {
+                    throw std::runtime_error("Duplicate bundle entry: " + name);
+                }
+            }
+            uint64_t offset = static_cast<uint64_t>(payload_.tellp());
+            serialize(obj, payload_, mode_);
+            entries_.push_back({name, offset, static_cast<uint64_t>(payload_.tellp()) - offset});
+            return *this;
+        }
+
+        void save(const std::string& filename) const {
+            std::ofstream outStream(filename, std::ios::binary);
+            if (!outStream) {
+                throw std::runtime_error("File cannot be created!");
+            }
+            writeBinary(outStream, magic);
+            size_t count = entries_.size();
+            writeBinary(outStream, count);
+            for (const auto& entry : entries_) {
+                serializeString(entry.name, outStream);
+                writeBinary(outStream, entry.offset);
+                writeBinary(outStream, entry.length);
+            }
+            const std::string payload = payload_.str();
+            outStream.write(payload.data(), payload.size());
+        }
+
+        static constexpr uint64_t magic = 0x454c444e55425342ull;     // "BSBUNDLE"
+
+    private:
+        struct Entry {
+            std::string name;
+            uint64_t offset;
+            uint64_t length;
+        };
+
+        Mode mode_;
+        std::vector<Entry> entries_;
+        std::ostringstream payload_;
+    };
+
+    // Reads a file written by BundleWriter. The file is memory-mapped once and entries are decoded in place.
+    class BundleReader {
+    public:
+        explicit BundleReader(const std::string& filename, Mode mode = Default) : file_(filename), mode_(mode) {
+            MemoryBuffer buffer(file_.data(), file_.size());
+            std::istream inStream(&buffer);
+            uint64_t magic = 0;
+            size_t count = 0;
+            readBinary(inStream, magic);
+            readBinary(inStream, count);
+            if (!inStream || magic != BundleWriter::magic) {
+                throw std::runtime_error("Not a bundle file!");
+            }
+            for (size_t i = 0; i < count; ++i) {
+                std::string name;
+                uint64_t offset = 0, length = 0;
+                deserializeString(name, inStream);
+                readBinary(inStream, offset);
+                readBinary(inStream, length);
+                if (!inStream) {
+                    throw std::runtime_error("Invalid bundle table of contents!");
+                }
+                entries_.emplace(std::move(name), std::make_pair(offset, length));
+            }
+            payloadBegin_ = static_cast<size_t>(inStream.tellg());
+            for (const auto& [name, range] : entries_) {
+                if (range.first > file_.size() - payloadBegin_ || range.second > file_.size() - payloadBegin_ - range.first) {
+                    throw std::runtime_error("Invalid bundle entry: " + name);
+                }
+            }
+        }
+
+        bool contains(const std::string& name) const {
+            return entries_.count(name) != 0;
+        }
+
+        std::vector<std::string> names() const {
+            std::vector<std::string> result;
+            for (const auto& entry : entries_) {
+                result.push_back(entry.first);
+            }
+            return result;
+        }
+
+        // Load one entry by name.
+        template<typename T>
+        void load(const std::string& name, T& obj) const {
+            auto it = entries_.find(name);
+            if (it == entries_.end()) {
+                throw std::runtime_error("Bundle entry not found: " + name);
+            }
+            MemoryBuffer buffer(file_.data() + payloadBegin_ + it->second.first, it->second.second);
+            std::istream inStream(&buffer);
+            deserialize(obj, inStream, mode_);
+        }
+
+        // Load several entries at once: loadAll("a", a, "b", b, ...).
+        template<typename T, typename... Rest>
+        void loadAll(const std::string& name, T& obj, Rest&&... rest) const {
+            load(name, obj);
+            if constexpr (sizeof...(Rest) > 0) {
+                loadAll(std::forward<Rest>(rest)...);
+            }
+        }
+
+    private:
+        MappedFile file_;
+        Mode mode_;
+        size_t payloadBegin_ = 0;
+        std::map<std::string, std::pair<uint64_t, uint64_t>> entries_;
+    };
+
+    /*
+    * Writes a sequence of T one element at a time, without holding the elements in memory.
+    * On a seekable stream the element count is backpatched when the writer finishes; otherwise elements are
+    * buffered in chunks of chunkSize and each chunk is written with its own count. Either way the result is read
+    * by the normal deserialize as Container (std::vector<T> by default, or e.g. std::list<T>, std::set<T>, or
+    * std::map<K, V> for T = std::pair<K, V>); any of them reads it, except that with TypeHeader the header names
+    * Container, so it must match the type read. Only modes that leave a top-level vector in its plain encoding
+    * are allowed.
+    * Call finish() to see write errors: the destructor finishes too, but cannot report them.
+    */
+    template<typename T, typename Container = std::vector<T>>
+    class SequenceWriter {
+    public:
+        static constexpr size_t chunkSize = 4096;
+
+        explicit SequenceWriter(const std::string& filename, Mode mode = Default)
+            : file_(filename, std::ios::binary), stream_(file_), context_{mode} {
+            if (!file_) {
+                throw std::runtime_error("File cannot be created!");
+            }
+            begin();
+        }
+
+        explicit SequenceWriter(std::ostream& stream, Mode mode = Default) : stream_(stream), context_{mode} {
+            begin();
+        }
+
+        // Finishes the sequence if finish() was not called, ignoring any error.
+        ~SequenceWriter() {
+            try {
+                finish();
+            } catch (...) {
+            }
+        }
+
+        SequenceWriter(const SequenceWriter&) = delete;
+        SequenceWriter& operator=(const SequenceWriter&) = delete;
+
+        void push(const T& element) {
+            if (finished_) {
+                throw std::runtime_error("SequenceWriter is already finished!");
+            }
+            serialize_(element, seekable_ ? stream_ : chunk_);
+            ++size_;
+            if (!seekable_ && ++chunkElements_ == chunkSize) {
+                flushChunk();
+            }
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        // Write the element count (or the last chunk and the terminator). Throws if the output failed.
+        void finish() {
+            if (finished_) {
+                return;
+            }
+            finished_ = true;
+            if (seekable_) {
+                std::streampos end = stream_.tellp();
+                stream_.seekp(countPosition_);
+                writeBinary(stream_, size_);
+                stream_.seekp(end);
+            } else {
+                flushChunk();
+                size_t terminator = 0;
+                writeBinary(stream_, terminator);
+            }
+            stream_.flush();
+            if (!stream_) {
+                throw std::runtime_error("Sequence cannot be written!");
+            }
+        }
+
+    private:
+        void begin() {
+            if (std::is_same_v<Container, std::vector<T>> && vectorEncoding<T>(context_.mode) != VectorEncoding::Plain) {
+                throw std::runtime_error("SequenceWriter cannot stream this vector encoding!");
+            }
+            writeHeader<Container>(stream_, context_.mode);
+            countPosition_ = stream_.tellp();
+            seekable_ = countPosition_ != std::streampos(-1);
+            if (seekable_) {
+                guard_.emplace(stream_, context_);
+                writeBinary(stream_, size_);
+            } else {
+                guard_.emplace(chunk_, context_);
+                writeBinary(stream_, chunkedCount);
+            }
+        }
+
+        void flushChunk() {
+            if (chunkElements_ == 0) {
+                return;
+            }
+            writeBinary(stream_, chunkElements_);
+            const std::string bytes = chunk_.str();
+            stream_.write(bytes.data(), bytes.size());
+            chunk_.str(std::string());
+            chunkElements_ = 0;
+        }
+
+        std::ofstream file_;
+        std::ostream& stream_;
+        Context context_;
+        std::ostringstream chunk_;
+        std::optional<ContextGuard> guard_;
+        std::streampos countPosition_;
+        bool seekable_ = false;
+        bool finished_ = false;
+        size_t size_ = 0;
+        size_t chunkElements_ = 0;
+    };
+
+    /*
+    * Reads a serialized sequence of T one element at a time, so files larger than memory can be processed.
+    * Only one element and the stream buffer (bufferSize bytes) are held at a time. Plain and chunked
+    * (SequenceWriter) counts are both accepted. With TypeHeader the header must name Container, the type
+    * the sequence was written as (std::vector<T> by default).
+    */
+    template<typename T, typename Container = std::vector<T>>
+    class SequenceReader {
+    public:
+        static constexpr size_t bufferSize = 1 << 16;
+
+        explicit SequenceReader(const std::string& filename, Mode mode = Default)
+            : buffer_(bufferSize), stream_(file_), context_{mode} {
+            file_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+            file_.open(filename, std::ios::binary);
+            if (!file_) {
+                throw std::runtime_error("File not found!");
+            }
+            begin_();
+        }
+
+        explicit SequenceReader(std::istream& stream, Mode mode = Default) : stream_(stream), context_{mode} {
+            begin_();
+        }
+
+        SequenceReader(const SequenceReader&) = delete;
+        SequenceReader& operator=(const SequenceReader&) = delete;
+
+        // Decode the next element into `element`; false at the end of the sequence.
+        bool next(T& element) {
+            while (remaining_ == 0) {
+                if (!chunked_) {
+                    return false;
+                }
+                readBinary(stream_, remaining_);
+                if (!stream_) {
+                    throw std::runtime_error("Unexpected end of file!");
+                }
+                if (remaining_ == 0) {
+                    chunked_ = false;
+                    return false;
+                }
+            }
+            deserialize_(element, stream_);
+            if (!stream_) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            --remaining_;
+            return true;
+        }
+
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            explicit iterator(SequenceReader* reader) : reader_(reader) {
+                ++*this;
+            }
+
+            reference operator*() const {
+                return element_;
+            }
+            pointer operator->() const {
+                return &element_;
+            }
+            iterator& operator++() {
+                if (!reader_->next(element_)) {
+                    reader_ = nullptr;
+                }
+                return *this;
+            }
+            void operator++(int) {
+                ++*this;
+            }
+            bool operator==(const iterator& other) const {
+                return reader_ == other.reader_;
+            }
+
+        private:
+            SequenceReader* reader_ = nullptr;
+            T element_{};
+        };
+
+        iterator begin() {
+            return iterator(this);
+        }
+
+        iterator end() {
+            return iterator();
+        }
+
+        // The same elements as a coroutine generator.
+        Generator<T> elements() {
+            T element{};
+            while (next(element)) {
+                co_yield element;
+            }
+        }
+
+    private:
+        void begin_() {
+            if (std::is_same_v<Container, std::vector<T>> && vectorEncoding<T>(context_.mode) != VectorEncoding::Plain) {
+                throw std::runtime_error("SequenceReader cannot stream this vector encoding!");
+            }
+            checkHeader<Container>(stream_, context_.mode);
+            guard_.emplace(stream_, context_);
+            readBinary(stream_, remaining_);
+            if (!stream_) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            if (remaining_ == chunkedCount) {
+                chunked_ = true;
+                remaining_ = 0;
+            }
+        }
+
+        std::vector<char> buffer_;
+        std::ifstream file_;
+        std::istream& stream_;
+        Context context_;
+        std::optional<ContextGuard> guard_;
+        size_t remaining_ = 0;
+        bool chunked_ = false;
+    };
+
 }
 
 // Macro for registering serialization and deserialization functions
@@ -219,7 +2123,43 @@ namespace binSerialization {
     } \
     void deserialize_(std::istream& stream) { \
         binSerialization::registerFunction([&](auto& member){binSerialization::deserialize_(member, stream);}, __VA_ARGS__); \
+    } \
+    constexpr auto binMembers_() const { \
+        return binSerialization::memberTuple(__VA_ARGS__); \
+    } \
+    constexpr auto binMembers_() { \
+        return binSerialization::memberTuple(__VA_ARGS__); \
     }
 
 
+// Macros for polymorphic hierarchies held through std::unique_ptr<Base>.
+// The base lists its own members; every derived type names its direct base, a unique non-zero id
+// within the hierarchy and its additional members. The base members are written first.
+#define REGISTER_BINSERIALIZATION_BASE(Base, ...) \
+    using binPolymorphicRoot_ = Base; \
+    virtual void serialize_(std::ostream& stream) const { \
+        __VA_OPT__(binSerialization::registerConstFunction([&](const auto& member){binSerialization::serialize_(member, stream);}, __VA_ARGS__);) \
+    } \
+    virtual void deserialize_(std::istream& stream) { \
+        __VA_OPT__(binSerialization::registerFunction([&](auto& member){binSerialization::deserialize_(member, stream);}, __VA_ARGS__);) \
+    } \
+    virtual size_t binTypeId_() const { \
+        return 0; \
+    }
+
+#define REGISTER_BINSERIALIZATION_DERIVED(Derived, Base, ID, ...) \
+    void serialize_(std::ostream& stream) const override { \
+        Base::serialize_(stream); \
+        __VA_OPT__(binSerialization::registerConstFunction([&](const auto& member){binSerialization::serialize_(member, stream);}, __VA_ARGS__);) \
+    } \
+    void deserialize_(std::istream& stream) override { \
+        Base::deserialize_(stream); \
+        __VA_OPT__(binSerialization::registerFunction([&](auto& member){binSerialization::deserialize_(member, stream);}, __VA_ARGS__);) \
+    } \
+    size_t binTypeId_() const override { \
+        return ID; \
+    } \
+    inline static const bool binRegistered_ = binSerialization::PolymorphicRegistry<binPolymorphicRoot_>::add( \
+        ID, &binSerialization::createPolymorphic<binPolymorphicRoot_, Derived>)
+
 #endif // _BIN_SERIALIZE_HPP_
@@ -0,0 +1,85 @@
+#ifndef _BIT_PACKING_HPP_
+#define _BIT_PACKING_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+* Fixed-width bit packing with frame of reference. Integers are split into blocks; every block stores its minimum
+* and the bit width of the largest offset from it, followed by the offsets packed little-endian, least significant
+* bit first. The kernels work on whole 64-bit words and have no data-dependent branches, so the compiler can
+* unroll and vectorize them.
+*/
+namespace binSerialization {
+
+    constexpr size_t bitPackingBlockSize = 128;
+
+    // Unpacking reads up to this many bytes past the end of the packed data.
+    constexpr size_t bitPackingPadding = 8;
+
+    inline size_t packedLength(size_t count, int width) {
+        return (count * width + 7) / 8;
+    }
+
+    // Bits needed for the largest of `count` values.
+    inline int bitWidth(const uint64_t* values, size_t count) {
+        uint64_t any = 0;
+        for (size_t i = 0; i < count; ++i) {
+            any |= values[i];
+        }
+        return static_cast<int>(std::bit_width(any));
+    }
+
+    // Pack `count` values of `width` bits into packedLength(count, width) bytes.
+    inline void packBits(const uint64_t* in, size_t count, int width, uint8_t* out) {
+        std::memset(out, 0, packedLength(count, width));
+        uint64_t accumulator = 0;
+        int filled = 0;
+        for (size_t i = 0; i < count; ++i) {
+            accumulator |= in[i] << filled;
+            filled += width;
+            if (filled >= 64) {
+                std::memcpy(out, &accumulator, 8);
+                out += 8;
+                filled -= 64;
+                accumulator = filled ? in[i] >> (width - filled) : 0;
+            }
+        }
+        std::memcpy(out, &accumulator, (filled + 7) / 8);
+    }
+
+    // Unpack `count` values of `width` bits. `in` must be followed by bitPackingPadding readable bytes.
+    inline void unpackBits(const uint8_t* in, size_t count, int width, uint64_t* out) {
+        if (width == 0) {
+            std::memset(out, 0, count * sizeof(uint64_t));
+            return;
+        }
+        const uint64_t mask = width == 64 ? ~0ull : (1ull << width) - 1;
+        if (width <= 56) {
+            for (size_t i = 0; i < count; ++i) {
+                size_t bit = i * width;
+                uint64_t word;
+                std::memcpy(&word, in + bit / 8, 8);
+                out[i] = (word >> (bit % 8)) & mask;
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            size_t bit = i * width;
+            uint64_t low, high = 0;
+            std::memcpy(&low, in + bit / 8, 8);
+            int shift = static_cast<int>(bit % 8);
+            if (shift + width > 64) {
+                high = in[bit / 8 + 8];
+                out[i] = ((low >> shift) | (high << (64 - shift))) & mask;
+            } else {
+                out[i] = (low >> shift) & mask;
+            }
+        }
+    }
+
+}
+
+#endif // _BIT_PACKING_HPP_
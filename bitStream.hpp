@@ -0,0 +1,94 @@
+#ifndef _BIT_STREAM_HPP_
+#define _BIT_STREAM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace binSerialization {
+
+    // Appends bit fields, most significant bit first, to a byte buffer.
+    class BitWriter {
+    public:
+        // Write the low `bits` bits of `value` (0 <= bits <= 64).
+        void write(uint64_t value, int bits) {
+            while (bits > 0) {
+                int room = 64 - pending_;
+                int take = bits < room ? bits : room;
+                uint64_t chunk = (value >> (bits - take)) & (take == 64 ? ~0ull : ((1ull << take) - 1));
+                accumulator_ = pending_ == 0 ? chunk : (accumulator_ << take) | chunk;
+                pending_ += take;
+                bits -= take;
+                if (pending_ == 64) {
+                    flushWord();
+                }
+            }
+        }
+
+        void writeBit(bool bit) {
+            write(bit ? 1 : 0, 1);
+        }
+
+        // Pad the last byte with zero bits and return the buffer.
+        std::vector<uint8_t>& finish() {
+            while (pending_ >= 8) {
+                pending_ -= 8;
+                bytes_.push_back(static_cast<uint8_t>(accumulator_ >> pending_));
+            }
+            if (pending_ > 0) {
+                bytes_.push_back(static_cast<uint8_t>(accumulator_ << (8 - pending_)));
+                pending_ = 0;
+            }
+            return bytes_;
+        }
+
+    private:
+        void flushWord() {
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                bytes_.push_back(static_cast<uint8_t>(accumulator_ >> shift));
+            }
+            accumulator_ = 0;
+            pending_ = 0;
+        }
+
+        std::vector<uint8_t> bytes_;
+        uint64_t accumulator_ = 0;
+        int pending_ = 0;
+    };
+
+    // Reads bit fields written by BitWriter.
+    class BitReader {
+    public:
+        BitReader(const uint8_t* data, size_t length) : data_(data), length_(length) {}
+
+        uint64_t read(int bits) {
+            if (bits > 0 && position_ + bits > length_ * 8) {
+                throw std::runtime_error("Unexpected end of bit stream!");
+            }
+            uint64_t value = 0;
+            while (bits > 0) {
+                size_t byte = position_ / 8;
+                int offset = static_cast<int>(position_ % 8);
+                int take = 8 - offset < bits ? 8 - offset : bits;
+                uint64_t chunk = (data_[byte] >> (8 - offset - take)) & ((1u << take) - 1);
+                value = (value << take) | chunk;
+                position_ += take;
+                bits -= take;
+            }
+            return value;
+        }
+
+        bool readBit() {
+            return read(1) != 0;
+        }
+
+    private:
+        const uint8_t* data_;
+        size_t length_;
+        size_t position_ = 0;
+    };
+
+}
+
+#endif // _BIT_STREAM_HPP_
@@ -0,0 +1,107 @@
+#ifndef _GENERATOR_HPP_
+#define _GENERATOR_HPP_
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+/*
+* A minimal C++20 coroutine generator (std::generator only arrives in C++23).
+* The coroutine yields lvalues; the iterator refers to the yielded object until the next increment.
+*/
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T* current = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+        reference operator*() const {
+            return *handle_.promise().current;
+        }
+        pointer operator->() const {
+            return handle_.promise().current;
+        }
+        iterator& operator++() {
+            handle_.resume();
+            rethrow();
+            return *this;
+        }
+        void operator++(int) {
+            ++*this;
+        }
+        bool operator==(std::default_sentinel_t) const {
+            return !handle_ || handle_.done();
+        }
+
+        void rethrow() const {
+            if (handle_.done() && handle_.promise().exception) {
+                std::rethrow_exception(handle_.promise().exception);
+            }
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    Generator& operator=(Generator&&) = delete;
+
+    ~Generator() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    iterator begin() {
+        handle_.resume();
+        iterator it(handle_);
+        it.rethrow();
+        return it;
+    }
+
+    std::default_sentinel_t end() const {
+        return {};
+    }
+
+private:
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+#endif // _GENERATOR_HPP_
@@ -0,0 +1,164 @@
+#ifndef _GORILLA_HPP_
+#define _GORILLA_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "bitStream.hpp"
+
+/*
+* Time series compression from Facebook's Gorilla paper (Pelkonen et al., VLDB 2015).
+* Floating-point values are XORed with their predecessor and only the meaningful bits of the XOR are stored;
+* timestamps are stored as delta-of-deltas in variable-size buckets.
+*/
+namespace binSerialization {
+
+    template<typename Float>
+    using FloatBits_t = std::conditional_t<sizeof(Float) == 8, uint64_t, uint32_t>;
+
+    /*
+    * XOR encoding of float or double values. After the first value, each value is
+    *     '0'                                  equal to the previous value,
+    *     '10' + bits                          XOR fits in the previous leading/trailing zero window,
+    *     '11' + 5-bit leading + 6-bit length + bits   a new window.
+    */
+    template<typename Float>
+    void gorillaEncode(const Float* in, size_t count, BitWriter& writer) {
+        using Bits = FloatBits_t<Float>;
+        constexpr int width = sizeof(Bits) * 8;
+        if (count == 0) {
+            return;
+        }
+        Bits previous = std::bit_cast<Bits>(in[0]);
+        writer.write(previous, width);
+        int previousLeading = -1, previousTrailing = 0;
+        for (size_t i = 1; i < count; ++i) {
+            Bits current = std::bit_cast<Bits>(in[i]);
+            Bits x = current ^ previous;
+            previous = current;
+            if (x == 0) {
+                writer.writeBit(false);
+                continue;
+            }
+            writer.writeBit(true);
+            int leading = std::countl_zero(x), trailing = std::countr_zero(x);
+            if (leading > 31) {
+                leading = 31;
+            }
+            if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+                writer.writeBit(false);
+                writer.write(x >> previousTrailing, width - previousLeading - previousTrailing);
+            } else {
+                int meaningful = width - leading - trailing;
+                writer.writeBit(true);
+                writer.write(leading, 5);
+                writer.write(meaningful - 1, 6);
+                writer.write(x >> trailing, meaningful);
+                previousLeading = leading;
+                previousTrailing = trailing;
+            }
+        }
+    }
+
+    template<typename Float>
+    void gorillaDecode(BitReader& reader, size_t count, Float* out) {
+        using Bits = FloatBits_t<Float>;
+        constexpr int width = sizeof(Bits) * 8;
+        if (count == 0) {
+            return;
+        }
+        Bits previous = static_cast<Bits>(reader.read(width));
+        out[0] = std::bit_cast<Float>(previous);
+        int leading = 0, trailing = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (reader.readBit()) {
+                if (reader.readBit()) {
+                    leading = static_cast<int>(reader.read(5));
+                    int meaningful = static_cast<int>(reader.read(6)) + 1;
+                    trailing = width - leading - meaningful;
+                    if (trailing < 0) {
+                        throw std::runtime_error("Invalid Gorilla data!");
+                    }
+                }
+                previous ^= static_cast<Bits>(reader.read(width - leading - trailing) << trailing);
+            }
+            out[i] = std::bit_cast<Float>(previous);
+        }
+    }
+
+    inline uint64_t zigzagEncode64(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t zigzagDecode64(uint64_t value) {
+        return static_cast<int64_t>((value >> 1) ^ (0ull - (value & 1)));
+    }
+
+    // Zigzagged delta-of-delta buckets: '0', '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits, '1111' + 64 bits.
+    inline void writeDeltaBucket(BitWriter& writer, uint64_t value) {
+        if (value == 0) {
+            writer.write(0b0, 1);
+        } else if (value < (1ull << 7)) {
+            writer.write(0b10, 2);
+            writer.write(value, 7);
+        } else if (value < (1ull << 9)) {
+            writer.write(0b110, 3);
+            writer.write(value, 9);
+        } else if (value < (1ull << 12)) {
+            writer.write(0b1110, 4);
+            writer.write(value, 12);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(value, 64);
+        }
+    }
+
+    inline uint64_t readDeltaBucket(BitReader& reader) {
+        int ones = 0;
+        while (ones < 4 && reader.readBit()) {
+            ++ones;
+        }
+        static constexpr int widths[] = {0, 7, 9, 12, 64};
+        return reader.read(widths[ones]);
+    }
+
+    /*
+    * Delta-of-delta encoding of 64-bit integers: the first value in full, then the first delta,
+    * then the change of each delta, all zigzagged into the buckets above.
+    * Regular timestamps cost one bit each.
+    */
+    template<typename Integer>
+    void deltaOfDeltaEncode(const Integer* in, size_t count, BitWriter& writer) {
+        static_assert(std::is_integral_v<Integer> && sizeof(Integer) == 8, "Delta-of-delta encodes 64-bit integers");
+        if (count == 0) {
+            return;
+        }
+        writer.write(static_cast<uint64_t>(in[0]), 64);
+        uint64_t previousDelta = 0;
+        for (size_t i = 1; i < count; ++i) {
+            uint64_t delta = static_cast<uint64_t>(in[i]) - static_cast<uint64_t>(in[i - 1]);
+            writeDeltaBucket(writer, zigzagEncode64(static_cast<int64_t>(delta - previousDelta)));
+            previousDelta = delta;
+        }
+    }
+
+    template<typename Integer>
+    void deltaOfDeltaDecode(BitReader& reader, size_t count, Integer* out) {
+        static_assert(std::is_integral_v<Integer> && sizeof(Integer) == 8, "Delta-of-delta decodes 64-bit integers");
+        if (count == 0) {
+            return;
+        }
+        uint64_t value = reader.read(64);
+        out[0] = static_cast<Integer>(value);
+        uint64_t delta = 0;
+        for (size_t i = 1; i < count; ++i) {
+            delta += static_cast<uint64_t>(zigzagDecode64(readDeltaBucket(reader)));
+            value += delta;
+            out[i] = static_cast<Integer>(value);
+        }
+    }
+
+}
+
+#endif // _GORILLA_HPP_
@@ -0,0 +1,113 @@
+#ifndef _MAPPED_FILE_HPP_
+#define _MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+* A read-only view of a whole file. On POSIX systems the file is memory-mapped;
+* elsewhere it is read into memory once.
+* A writable view is a private copy-on-write mapping followed by a NUL byte, for parsers that work in place:
+* only the pages written to are copied, and the writes never reach the file.
+*/
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename, bool writable = false) {
+#ifdef MAPPED_FILE_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("File not found!");
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw std::runtime_error("File cannot be read!");
+        }
+        size_ = static_cast<size_t>(status.st_size);
+        if (writable) {
+            // Reserve zeroed pages one byte longer than the file and map the file over their start, so the byte
+            // after the data is a NUL even when the file ends on a page boundary.
+            size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            mappedSize_ = (size_ + page) / page * page;
+            void* address = ::mmap(nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (address == MAP_FAILED || (size_ > 0
+                    && ::mmap(address, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+                if (address != MAP_FAILED) {
+                    ::munmap(address, mappedSize_);
+                }
+                ::close(fd);
+                throw std::runtime_error("File cannot be mapped!");
+            }
+            data_ = static_cast<char*>(address);
+        } else if (size_ > 0) {
+            void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("File cannot be mapped!");
+            }
+            data_ = static_cast<char*>(address);
+            mappedSize_ = size_;
+        }
+        ::close(fd);
+#else
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("File not found!");
+        }
+        size_ = static_cast<size_t>(file.tellg());
+        buffer_.assign(size_ + 1, '\0');
+        file.seekg(0);
+        file.read(buffer_.data(), size_);
+        data_ = buffer_.data();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef MAPPED_FILE_MMAP
+        if (data_) {
+            ::munmap(data_, mappedSize_);
+        }
+#endif
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          mappedSize_(std::exchange(other.mappedSize_, 0)), buffer_(std::move(other.buffer_)) {}
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    const char* data() const {
+        return data_;
+    }
+
+    // The data of a writable view, followed by a NUL byte.
+    char* writableData() {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t mappedSize_ = 0;
+    std::vector<char> buffer_;
+};
+
+#endif // _MAPPED_FILE_HPP_
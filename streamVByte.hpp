@@ -0,0 +1,209 @@
+#ifndef _STREAM_VBYTE_HPP_
+#define _STREAM_VBYTE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define STREAM_VBYTE_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+* Stream VByte integer codec (Lemire, Kurz, Rupp).
+* Every 32-bit integer is stored in 1-4 little-endian bytes. The byte counts of four integers are packed as
+* 2-bit codes into one control byte, and control bytes are kept apart from the data bytes, so decoding a group
+* of four integers is a single table-driven byte shuffle. The shuffle uses SSSE3 or AVX2 when the CPU has it
+* and falls back to a scalar loop otherwise.
+*/
+namespace binSerialization {
+
+    // Decoding reads up to this many bytes past the end of the data.
+    constexpr size_t streamVByteDecodePadding = 16;
+
+    struct StreamVByteTables {
+        std::array<std::array<uint8_t, 16>, 256> shuffle{};
+        std::array<uint8_t, 256> length{};
+    };
+
+    constexpr StreamVByteTables makeStreamVByteTables() {
+        StreamVByteTables tables;
+        for (int control = 0; control < 256; ++control) {
+            uint8_t offset = 0;
+            for (int i = 0; i < 4; ++i) {
+                int length = ((control >> (2 * i)) & 3) + 1;
+                for (int byte = 0; byte < 4; ++byte) {
+                    tables.shuffle[control][4 * i + byte] = byte < length ? static_cast<uint8_t>(offset + byte) : 0x80;
+                }
+                offset += length;
+            }
+            tables.length[control] = offset;
+        }
+        return tables;
+    }
+
+    inline constexpr StreamVByteTables streamVByteTables = makeStreamVByteTables();
+
+    inline uint32_t zigzagEncode32(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    inline uint32_t zigzagDecode32(uint32_t value) {
+        return (value >> 1) ^ (0u - (value & 1));
+    }
+
+    inline size_t streamVByteControlLength(size_t count) {
+        return (count + 3) / 4;
+    }
+
+    // Number of data bytes described by the control bytes of `count` integers.
+    inline size_t streamVByteDataLength(const uint8_t* control, size_t count) {
+        size_t length = 0;
+        for (size_t group = 0; group < count / 4; ++group) {
+            length += streamVByteTables.length[control[group]];
+        }
+        for (size_t i = count / 4 * 4; i < count; ++i) {
+            length += ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        }
+        return length;
+    }
+
+    /*
+    * Encode `count` integers. Signed integers are zigzag-encoded first so that small negative values stay short.
+    * @param
+    *     control: room for streamVByteControlLength(count) bytes.
+    *     data: room for 4 * count bytes.
+    * @return the number of data bytes written.
+    */
+    template<typename T>
+    size_t streamVByteEncode(const T* in, size_t count, uint8_t* control, uint8_t* data) {
+        static_assert(std::is_integral_v<T> && sizeof(T) == 4, "Stream VByte encodes 32-bit integers");
+        std::memset(control, 0, streamVByteControlLength(count));
+        uint8_t* out = data;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t value;
+            if constexpr (std::is_signed_v<T>) {
+                value = zigzagEncode32(in[i]);
+            } else {
+                value = in[i];
+            }
+            int code = (value > 0xff) + (value > 0xffff) + (value > 0xffffff);
+            control[i / 4] |= static_cast<uint8_t>(code << (2 * (i % 4)));
+            for (int byte = 0; byte <= code; ++byte) {
+                *out++ = static_cast<uint8_t>(value >> (8 * byte));
+            }
+        }
+        return out - data;
+    }
+
+    template<bool ZigZag>
+    const uint8_t* streamVByteDecodeScalar(const uint8_t* control, const uint8_t* data, size_t begin, size_t count, uint32_t* out) {
+        for (size_t i = begin; i < count; ++i) {
+            int length = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+            uint32_t value = 0;
+            for (int byte = 0; byte < length; ++byte) {
+                value |= static_cast<uint32_t>(data[byte]) << (8 * byte);
+            }
+            data += length;
+            out[i] = ZigZag ? zigzagDecode32(value) : value;
+        }
+        return data;
+    }
+
+#ifdef STREAM_VBYTE_X86
+    template<bool ZigZag>
+    __attribute__((target("ssse3")))
+    inline __m128i streamVByteDecodeGroup(const uint8_t*& data, uint8_t control) {
+        __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(streamVByteTables.shuffle[control].data()));
+        __m128i values = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+        data += streamVByteTables.length[control];
+        if constexpr (ZigZag) {
+            __m128i sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi32(1)));
+            values = _mm_xor_si128(_mm_srli_epi32(values, 1), sign);
+        }
+        return values;
+    }
+
+    template<bool ZigZag>
+    __attribute__((target("ssse3")))
+    void streamVByteDecodeSSSE3(const uint8_t* control, const uint8_t* data, size_t count, uint32_t* out) {
+        size_t groups = count / 4;
+        for (size_t group = 0; group < groups; ++group) {
+            __m128i values = streamVByteDecodeGroup<ZigZag>(data, control[group]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * group), values);
+        }
+        streamVByteDecodeScalar<ZigZag>(control, data, groups * 4, count, out);
+    }
+
+    // Two groups per iteration: each 128-bit lane of vpshufb shuffles one group.
+    template<bool ZigZag>
+    __attribute__((target("avx2")))
+    void streamVByteDecodeAVX2(const uint8_t* control, const uint8_t* data, size_t count, uint32_t* out) {
+        size_t groups = count / 4;
+        size_t group = 0;
+        for (; group + 2 <= groups; group += 2) {
+            uint8_t low = control[group], high = control[group + 1];
+            const uint8_t* highData = data + streamVByteTables.length[low];
+            __m256i bytes = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(highData)), 1);
+            __m256i mask = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(streamVByteTables.shuffle[low].data()))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(streamVByteTables.shuffle[high].data())), 1);
+            __m256i values = _mm256_shuffle_epi8(bytes, mask);
+            if constexpr (ZigZag) {
+                __m256i sign = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(values, _mm256_set1_epi32(1)));
+                values = _mm256_xor_si256(_mm256_srli_epi32(values, 1), sign);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * group), values);
+            data = highData + streamVByteTables.length[high];
+        }
+        for (; group < groups; ++group) {
+            __m128i values = streamVByteDecodeGroup<ZigZag>(data, control[group]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * group), values);
+        }
+        streamVByteDecodeScalar<ZigZag>(control, data, groups * 4, count, out);
+    }
+#endif
+
+    template<bool ZigZag>
+    void streamVByteDecodeFallback(const uint8_t* control, const uint8_t* data, size_t count, uint32_t* out) {
+        streamVByteDecodeScalar<ZigZag>(control, data, 0, count, out);
+    }
+
+    using StreamVByteKernel = void (*)(const uint8_t*, const uint8_t*, size_t, uint32_t*);
+
+    // Pick the widest kernel the running CPU supports, once per process.
+    template<bool ZigZag>
+    StreamVByteKernel streamVByteKernel() {
+        static const StreamVByteKernel kernel = [] {
+#ifdef STREAM_VBYTE_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return &streamVByteDecodeAVX2<ZigZag>;
+            }
+            if (__builtin_cpu_supports("ssse3")) {
+                return &streamVByteDecodeSSSE3<ZigZag>;
+            }
+#endif
+            return &streamVByteDecodeFallback<ZigZag>;
+        }();
+        return kernel;
+    }
+
+    /*
+    * Decode `count` integers written by streamVByteEncode.
+    * `data` must be followed by streamVByteDecodePadding readable bytes.
+    */
+    template<typename T>
+    void streamVByteDecode(const uint8_t* control, const uint8_t* data, size_t count, T* out) {
+        static_assert(std::is_integral_v<T> && sizeof(T) == 4, "Stream VByte decodes 32-bit integers");
+        streamVByteKernel<std::is_signed_v<T>>()(control, data, count, reinterpret_cast<uint32_t*>(out));
+    }
+
+}
+
+#endif // _STREAM_VBYTE_HPP_
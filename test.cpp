@@ -3,8 +3,11 @@
 #include <set>
 #include <vector>
 #include <list>
+#include <bitset>
 #include <string>
 #include <cassert>
+#include <memory>
+#include <limits>
 #include "binSerialization.hpp"
 #include "xmlSerialization.hpp"
 
@@ -23,6 +26,153 @@ struct person {
     REGISTER_XMLSERIALIZATION(name, age, scores);
 };
 
+struct point {
+    float x, y, z;
+    int id;
+    bool operator == (const point& other) const {
+        return x == other.x && y == other.y && z == other.z && id == other.id;
+    }
+    REGISTER_BINSERIALIZATION(x, y, z, id);
+};
+
+struct padded {
+    char tag;
+    int value;
+    REGISTER_BINSERIALIZATION(tag, value);
+};
+
+// Registered in an order other than the declaration order.
+struct reordered {
+    float x;
+    int id;
+    REGISTER_BINSERIALIZATION(id, x);
+};
+
+// Has no default constructor, so it is always written member by member.
+struct anchored {
+    float x, y;
+    anchored(float x, float y) : x(x), y(y) {}
+    REGISTER_BINSERIALIZATION(x, y);
+};
+
+// Registers one member twice and leaves the other out.
+struct repeated {
+    int a, b;
+    REGISTER_BINSERIALIZATION(a, a);
+};
+
+// An output buffer that cannot seek, like a pipe.
+struct pipeBuffer : std::streambuf {
+    std::string data;
+    int overflow(int ch) override {
+        if (ch != traits_type::eof()) {
+            data += static_cast<char>(ch);
+        }
+        return ch;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        data.append(s, n);
+        return n;
+    }
+};
+
+// Encode `values` once and decode the buffer with every Stream VByte kernel the CPU supports.
+template<typename T>
+void checkStreamVByteKernels(const std::vector<T>& values) {
+    constexpr bool zigzag = std::is_signed_v<T>;
+    size_t count = values.size();
+    std::vector<uint8_t> control(streamVByteControlLength(count));
+    std::vector<uint8_t> data(4 * count + streamVByteDecodePadding);
+    streamVByteEncode(values.data(), count, control.data(), data.data());
+    std::vector<uint32_t> expected(count), decoded(count);
+    for (size_t i = 0; i < count; ++i) {
+        expected[i] = static_cast<uint32_t>(values[i]);
+    }
+    streamVByteDecodeFallback<zigzag>(control.data(), data.data(), count, decoded.data());
+    assert(decoded == expected);
+#ifdef STREAM_VBYTE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        decoded.assign(count, 0);
+        streamVByteDecodeSSSE3<zigzag>(control.data(), data.data(), count, decoded.data());
+        assert(decoded == expected);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        decoded.assign(count, 0);
+        streamVByteDecodeAVX2<zigzag>(control.data(), data.data(), count, decoded.data());
+        assert(decoded == expected);
+    }
+#endif
+}
+
+enum class color : unsigned char { red, green, blue };
+
+// Written by hand against the DOM, without REGISTER_XMLSERIALIZATION.
+struct celsius {
+    double degrees;
+    bool operator == (const celsius& other) const {
+        return degrees == other.degrees;
+    }
+    void serialize_xml_(XMLDocument& doc, XMLElement* parent) const {
+        XMLElement* element = doc.NewElement("celsius");
+        element->SetText(degrees);
+        parent->InsertEndChild(element);
+    }
+    void deserialize_xml_(XMLDocument& doc, XMLElement* parent) {
+        XMLElement* element = parent->FirstChildElement("celsius");
+        element->QueryDoubleText(&degrees);
+        if (xmlSerialization::modeOf(doc) & Compact) {
+            parent->DeleteChild(element);
+        }
+    }
+};
+
+struct reading {
+    std::string where;
+    celsius temp;
+    int sensor;
+    bool operator == (const reading& other) const {
+        return where == other.where && temp == other.temp && sensor == other.sensor;
+    }
+    REGISTER_XMLSERIALIZATION(where, temp, sensor);
+};
+
+struct series {
+    std::vector<long long> timestamps;
+    std::vector<double> values;
+    bool operator == (const series& other) const {
+        return timestamps == other.timestamps && values == other.values;
+    }
+    REGISTER_BINSERIALIZATION(withMode<DeltaOfDelta>(timestamps), withMode<XorFloat>(values));
+};
+
+struct shape {
+    std::string label;
+    virtual ~shape() = default;
+    virtual double area() const = 0;
+    REGISTER_BINSERIALIZATION_BASE(shape, label);
+};
+
+struct circle : shape {
+    double radius = 0;
+    double area() const override {
+        return 3 * radius * radius;
+    }
+    REGISTER_BINSERIALIZATION_DERIVED(circle, shape, 1, radius);
+};
+
+struct rectangle : shape {
+    double width = 0, height = 0;
+    double area() const override {
+        return width * height;
+    }
+    REGISTER_BINSERIALIZATION_DERIVED(rectangle, shape, 2, width, height);
+};
+
+struct square : rectangle {
+    REGISTER_BINSERIALIZATION_DERIVED(square, rectangle, 3);
+};
+
 int main() {
     // built-in type
     int a = 123, b;
@@ -197,6 +347,484 @@ int main() {
     assert(m5 == m6);
     std::cout << "xml::test<map<string, vector<person>>> (with base64) passed." << std::endl;
 
+    // encoding modes
+    serialize(m5, "serialization_file/map_person_dict.bin", StringDictionary);
+    deserialize(m6, "serialization_file/map_person_dict.bin", StringDictionary);
+    assert(m5 == m6);
+    std::cout << "bin::test<map<string, vector<person>>> (with string dictionary) passed." << std::endl;
+
+    std::vector<person> v5 = {p1, {"Bob", 30, {60}}, {"", 40, {}}}, v6;
+    serialize(v5, "serialization_file/vector_person_columnar.bin", Columnar);
+    deserialize(v6, "serialization_file/vector_person_columnar.bin", Columnar);
+    assert(v5 == v6);
+    std::cout << "bin::test<vector<person>> (columnar) passed." << std::endl;
+    serialize(m5, "serialization_file/map_person_columnar.bin", Columnar | StringDictionary);
+    deserialize(m6, "serialization_file/map_person_columnar.bin", Columnar | StringDictionary);
+    assert(m5 == m6);
+    std::cout << "bin::test<map<string, vector<person>>> (columnar, with string dictionary) passed." << std::endl;
+
+    std::vector<int> v7, v8;
+    for (int i = 0; i < 1000; ++i) {
+        v7.push_back(i % 7 == 0 ? -i * 1000 : i);
+    }
+    v7.push_back(std::numeric_limits<int>::min());
+    v7.push_back(std::numeric_limits<int>::max());
+    serialize(v7, "serialization_file/vector_vbyte.bin", StreamVByte);
+    deserialize(v8, "serialization_file/vector_vbyte.bin", StreamVByte);
+    assert(v7 == v8);
+    std::cout << "bin::test<vector<int>> (stream vbyte) passed." << std::endl;
+    // 13 and 27 values leave an odd number of full groups plus a partial one for the AVX2 kernel.
+    for (size_t count : {1, 3, 5, 8, 13, 27, 64}) {
+        std::vector<uint32_t> unsignedValues;
+        std::vector<int32_t> signedValues;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t value = static_cast<uint32_t>(i * 2654435761u) >> (8 * (i % 4));
+            unsignedValues.push_back(value);
+            signedValues.push_back(i % 2 ? -static_cast<int32_t>(value >> 1) : static_cast<int32_t>(value >> 1));
+        }
+        unsignedValues.back() = std::numeric_limits<uint32_t>::max();
+        signedValues.back() = std::numeric_limits<int32_t>::min();
+        checkStreamVByteKernels(unsignedValues);
+        checkStreamVByteKernels(signedValues);
+    }
+    std::cout << "bin::test<stream vbyte kernels> passed." << std::endl;
+
+    series r1, r2;
+    for (int i = 0; i < 1000; ++i) {
+        r1.timestamps.push_back(1700000000000LL + i * 1000 + (i % 10 == 0 ? 3 : 0));
+        r1.values.push_back(20.0 + (i % 50) * 0.25);
+    }
+    r1.values.push_back(-0.0);
+    r1.values.push_back(std::numeric_limits<double>::infinity());
+    r1.timestamps.push_back(std::numeric_limits<long long>::min());
+    r1.timestamps.push_back(std::numeric_limits<long long>::max());
+    serialize(r1, "serialization_file/series.bin");
+    deserialize(r2, "serialization_file/series.bin");
+    assert(r1 == r2);
+    std::vector<series> r3 = {r1, series{{1, 2, 4}, {0.5, 0.75, 1.0}}, series{}}, r4, r5;
+    serialize(r3, "serialization_file/vector_series.bin");
+    deserialize(r4, "serialization_file/vector_series.bin");
+    assert(r3 == r4);
+    serialize(r3, "serialization_file/vector_series_columnar.bin", Columnar);
+    deserialize(r5, "serialization_file/vector_series_columnar.bin", Columnar);
+    assert(r3 == r5);
+    std::cout << "bin::test<series> (delta-of-delta and xor members) passed." << std::endl;
+    std::vector<std::pair<long long, float>> t1, t2;
+    for (int i = 0; i < 100; ++i) {
+        t1.push_back({i * 60LL, 1.5f + (i % 3)});
+    }
+    serialize(t1, "serialization_file/vector_timeseries.bin", XorFloat);
+    deserialize(t2, "serialization_file/vector_timeseries.bin", XorFloat);
+    assert(t1 == t2);
+    std::cout << "bin::test<vector<pair<long long, float>>> (xor) passed." << std::endl;
+
+    std::vector<bool> f1 = {true, false, true, true, false, false, true, false, true}, f2;
+    serialize(f1, "serialization_file/vector_bool.bin");
+    deserialize(f2, "serialization_file/vector_bool.bin");
+    assert(f1 == f2);
+    std::ostringstream boolBytes, packedBoolBytes;
+    serialize(f1, boolBytes);
+    serialize(f1, packedBoolBytes, BitPacked);
+    assert(boolBytes.str().size() == sizeof(size_t) + f1.size() && packedBoolBytes.str().size() == sizeof(size_t) + 2);
+    f2.clear();
+    serialize(f1, "serialization_file/vector_bool_packed.bin", BitPacked);
+    deserialize(f2, "serialization_file/vector_bool_packed.bin", BitPacked);
+    assert(f1 == f2);
+    std::cout << "bin::test<vector<bool>> passed." << std::endl;
+    std::bitset<20> b1(0xA5F3C), b2, b3;
+    serialize(b1, "serialization_file/bitset.bin");
+    deserialize(b2, "serialization_file/bitset.bin");
+    assert(b1 == b2);
+    serialize(b1, "serialization_file/bitset_packed.bin", BitPacked);
+    deserialize(b3, "serialization_file/bitset_packed.bin", BitPacked);
+    assert(b1 == b3);
+    std::cout << "bin::test<bitset<20>> passed." << std::endl;
+    std::vector<color> c1, c2;
+    std::vector<long long> k1, k2;
+    for (int i = 0; i < 300; ++i) {
+        c1.push_back(static_cast<color>(i % 3));
+        k1.push_back(i % 17 - 8);
+    }
+    k1.push_back(std::numeric_limits<long long>::min());
+    serialize(c1, "serialization_file/vector_enum_packed.bin", BitPacked);
+    deserialize(c2, "serialization_file/vector_enum_packed.bin", BitPacked);
+    assert(c1 == c2);
+    std::cout << "bin::test<vector<enum>> (bit-packed) passed." << std::endl;
+    serialize(k1, "serialization_file/vector_packed.bin", BitPacked);
+    deserialize(k2, "serialization_file/vector_packed.bin", BitPacked);
+    assert(k1 == k2);
+    std::cout << "bin::test<vector<long long>> (bit-packed) passed." << std::endl;
+
+    static_assert(typeFingerprint_v<person> != typeFingerprint_v<std::map<int, std::string>>);
+    static_assert(typeFingerprint_v<std::vector<int>> != typeFingerprint_v<std::list<int>>);
+    serialize(p1, "serialization_file/person_header.bin", TypeHeader);
+    deserialize(p2, "serialization_file/person_header.bin", TypeHeader);
+    assert(p1 == p2);
+    bool rejected = false;
+    try {
+        deserialize(m2, "serialization_file/person_header.bin", TypeHeader);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::cout << "bin::test<person> (type header) passed." << std::endl;
+
+    static_assert(isRawStruct_v<point> && !isRawStruct_v<padded> && !isRawStruct_v<person>);
+    std::vector<point> q1, q2;
+    for (int i = 0; i < 100; ++i) {
+        q1.push_back({i * 0.5f, i * 1.5f, -i * 2.0f, i});
+    }
+    serialize(q1, "serialization_file/vector_point.bin");
+    deserialize(q2, "serialization_file/vector_point.bin");
+    assert(q1 == q2);
+    static_assert(!isRawStruct_v<reordered> && !isRawStruct_v<repeated> && !isRawStruct_v<anchored>);
+    std::stringstream anchoredBytes;
+    anchored a1(1.5f, -2.5f), a2(0, 0);
+    serialize(a1, anchoredBytes);
+    deserialize(a2, anchoredBytes);
+    assert(a2.x == 1.5f && a2.y == -2.5f);
+    std::ostringstream reorderedBytes, pairBytes;
+    serialize(std::vector<reordered>{{1.5f, 7}, {-2.0f, 8}}, reorderedBytes);
+    serialize(std::vector<std::pair<int, float>>{{7, 1.5f}, {8, -2.0f}}, pairBytes);
+    assert(reorderedBytes.str() == pairBytes.str());
+    std::ostringstream repeatedBytes, repeatedPairBytes;
+    serialize(std::vector<repeated>{{1, 2}, {3, 4}}, repeatedBytes);
+    serialize(std::vector<std::pair<int, int>>{{1, 1}, {3, 3}}, repeatedPairBytes);
+    assert(repeatedBytes.str() == repeatedPairBytes.str());
+    std::cout << "bin::test<vector<point>> (raw struct) passed." << std::endl;
+
+    BundleWriter writer(StringDictionary);
+    writer.add("person", p1).add("map", m5).add("points", q1).add("pi", d);
+    writer.save("serialization_file/bundle.bin");
+    BundleReader reader("serialization_file/bundle.bin", StringDictionary);
+    person p3;
+    reader.load("person", p3);
+    assert(p3 == p1);
+    double pi = 0;
+    m6.clear();
+    q2.clear();
+    reader.loadAll("map", m6, "points", q2, "pi", pi);
+    assert(m6 == m5 && q2 == q1 && pi == d);
+    assert(reader.contains("map") && !reader.contains("missing"));
+    std::cout << "bin::test<bundle> passed." << std::endl;
+
+    serialize(m5, "serialization_file/map_person_small.bin", SmallString);
+    deserialize(m6, "serialization_file/map_person_small.bin", SmallString);
+    assert(m5 == m6);
+    std::vector<std::string> w1 = {"", "a", std::string(254, 'x'), std::string(255, 'y'), std::string(1000, 'z'), "a"}, w2;
+    serialize(w1, "serialization_file/vector_string_small.bin", SmallString | StringDictionary);
+    deserialize(w2, "serialization_file/vector_string_small.bin", SmallString | StringDictionary);
+    assert(w1 == w2);
+    std::cout << "bin::test<vector<string>> (small string) passed." << std::endl;
+
+    std::map<std::string, std::vector<person>> m7 = m5;
+    m7["Alice"][0].age = 21;
+    m7.erase("Bob");
+    m7["Carol"] = {p1};
+    serializeDelta(m7, m5, "serialization_file/map_person_delta.bin");
+    m6 = m5;
+    applyDelta(m6, "serialization_file/map_person_delta.bin");
+    assert(m6 == m7);
+    std::vector<int> v9 = v7, v10 = v7;
+    v9[500] = 42;
+    v9.push_back(7);
+    serializeDelta(v9, v7, "serialization_file/vector_delta.bin");
+    applyDelta(v10, "serialization_file/vector_delta.bin");
+    assert(v9 == v10);
+    std::set<int> s5 = {6, 8, 11}, s6 = s1;
+    serializeDelta(s5, s1, "serialization_file/set_delta.bin");
+    applyDelta(s6, "serialization_file/set_delta.bin");
+    assert(s5 == s6);
+    std::cout << "bin::test<delta> passed." << std::endl;
+
+    {
+        SequenceWriter<person> sequence("serialization_file/sequence_person.bin", StringDictionary);
+        for (const auto& p : v5) {
+            sequence.push(p);
+        }
+    }
+    v6.clear();
+    deserialize(v6, "serialization_file/sequence_person.bin", StringDictionary);
+    assert(v5 == v6);
+    pipeBuffer pipe;
+    std::ostream pipeStream(&pipe);
+    SequenceWriter<int> chunked(pipeStream);
+    for (int i = 0; i < 10000; ++i) {
+        chunked.push(i);
+    }
+    chunked.finish();
+    MemoryBuffer pipeInput(pipe.data.data(), pipe.data.size());
+    std::istream pipeInStream(&pipeInput);
+    std::list<int> l3;
+    deserialize(l3, pipeInStream);
+    assert(l3.size() == 10000 && l3.back() == 9999);
+    pipeInStream.seekg(0);
+    std::vector<int> v11;
+    deserialize(v11, pipeInStream);
+    assert(v11.size() == 10000 && v11[4096] == 4096);
+    pipeBuffer pairPipe;
+    std::ostream pairPipeStream(&pairPipe);
+    SequenceWriter<std::pair<int, std::string>> chunkedPairs(pairPipeStream);
+    for (int i = 0; i < 5000; ++i) {
+        chunkedPairs.push({i, std::to_string(i)});
+    }
+    chunkedPairs.finish();
+    MemoryBuffer pairPipeInput(pairPipe.data.data(), pairPipe.data.size());
+    std::istream pairPipeInStream(&pairPipeInput);
+    std::map<int, std::string> chunkedMap;
+    deserialize(chunkedMap, pairPipeInStream);
+    assert(chunkedMap.size() == 5000 && chunkedMap[4999] == "4999");
+    {
+        SequenceWriter<int, std::list<int>> headed("serialization_file/sequence_list.bin", TypeHeader);
+        for (int i = 0; i < 100; ++i) {
+            headed.push(i);
+        }
+        headed.finish();
+    }
+    std::list<int> l4;
+    deserialize(l4, "serialization_file/sequence_list.bin", TypeHeader);
+    assert(l4.size() == 100 && l4.back() == 99);
+    int headedSum = 0;
+    for (int i : SequenceReader<int, std::list<int>>("serialization_file/sequence_list.bin", TypeHeader)) {
+        headedSum += i;
+    }
+    assert(headedSum == 4950);
+    std::cout << "bin::test<sequence writer> passed." << std::endl;
+
+    SequenceReader<person> sequenceReader("serialization_file/sequence_person.bin", StringDictionary);
+    v6.clear();
+    for (const person& p : sequenceReader) {
+        v6.push_back(p);
+    }
+    assert(v5 == v6);
+    MemoryBuffer chunkedInput(pipe.data.data(), pipe.data.size());
+    std::istream chunkedInStream(&chunkedInput);
+    SequenceReader<int> chunkedReader(chunkedInStream);
+    long long total = 0;
+    for (int i : chunkedReader.elements()) {
+        total += i;
+    }
+    assert(total == 9999LL * 10000 / 2);
+    std::cout << "bin::test<sequence reader> passed." << std::endl;
+
+    deserialize(m6, "serialization_file/map_person.bin");
+    const int* reusedScores = m6["Alice"][0].scores.data();
+    deserialize(m6, "serialization_file/map_person.bin", ReuseCapacity);
+    assert(m5 == m6 && m6["Alice"][0].scores.data() == reusedScores);
+    v6 = v5;
+    v6.push_back(p1);
+    deserialize(v6, "serialization_file/vector_person_columnar.bin", Columnar | ReuseCapacity);
+    assert(v5 == v6);
+    std::list<person> l7 = {p1, p1, p1, p1}, l8(v5.begin(), v5.end());
+    serialize(l8, "serialization_file/list_person.bin");
+    deserialize(l7, "serialization_file/list_person.bin", ReuseCapacity);
+    assert(l7 == l8);
+    std::cout << "bin::test<reuse capacity> passed." << std::endl;
+
+    std::vector<std::unique_ptr<shape>> shapes1, shapes2;
+    auto wheel = std::make_unique<circle>();
+    wheel->label = "wheel";
+    wheel->radius = 2;
+    auto door = std::make_unique<rectangle>();
+    door->label = "door";
+    door->width = 1;
+    door->height = 2;
+    auto tile = std::make_unique<square>();
+    tile->width = tile->height = 3;
+    shapes1.push_back(std::move(wheel));
+    shapes1.push_back(nullptr);
+    shapes1.push_back(std::move(door));
+    shapes1.push_back(std::move(tile));
+    serialize(shapes1, "serialization_file/vector_shape.bin", TypeHeader);
+    deserialize(shapes2, "serialization_file/vector_shape.bin", TypeHeader);
+    assert(shapes2.size() == 4 && shapes2[1] == nullptr);
+    assert(dynamic_cast<circle*>(shapes2[0].get()) && shapes2[0]->label == "wheel" && shapes2[0]->area() == 12);
+    assert(dynamic_cast<rectangle*>(shapes2[2].get()) && shapes2[2]->label == "door" && shapes2[2]->area() == 2);
+    assert(dynamic_cast<square*>(shapes2[3].get()) && shapes2[3]->area() == 9);
+    std::unique_ptr<person> owner1 = std::make_unique<person>(p1), owner2;
+    serialize(owner1, "serialization_file/unique_ptr_person.bin");
+    deserialize(owner2, "serialization_file/unique_ptr_person.bin");
+    assert(owner2 && *owner2 == *owner1);
+    std::cout << "bin::test<polymorphic> passed." << std::endl;
+
+    alignas(8) static constexpr auto primes = embed<[] { return std::vector<int>{2, 3, 5, 7, 11}; }>();
+    static_assert(primes.size() == sizeof(size_t) + 5 * sizeof(int));
+    std::span<const int> primeView = viewVector<int>(primes);
+    assert(primeView.size() == 5 && primeView[4] == 11);
+    static constexpr auto greeting = embed<[] { return std::string("hello, world"); }>();
+    assert(viewString(greeting) == "hello, world");
+    static constexpr auto embeddedPerson = embed<[] { return person{"Alice", 20, {90, 80, 70}}; }>();
+    person p9;
+    deserialize(p9, embeddedPerson);
+    assert(p9 == (person{"Alice", 20, {90, 80, 70}}));
+    using landmarks = std::vector<std::pair<std::string, std::vector<point>>>;
+    static constexpr auto embeddedLandmarks = embed<[] { return landmarks{{"origin", {{0, 0, 0, 1}}}, {"unit", {{1, 1, 1, 2}}}}; }>();
+    std::ostringstream runtimeLandmarks;
+    serialize(landmarks{{"origin", {{0, 0, 0, 1}}}, {"unit", {{1, 1, 1, 2}}}}, runtimeLandmarks);
+    assert(runtimeLandmarks.str() == std::string(reinterpret_cast<const char*>(embeddedLandmarks.data()), embeddedLandmarks.size()));
+    std::cout << "bin::test<constexpr embed> passed." << std::endl;
+
+    // xml modes
+    std::vector<int> x1(2000), x2;
+    for (size_t i = 0; i < x1.size(); ++i) {
+        x1[i] = static_cast<int>(i * 7);
+    }
+    serialize_xml(x1, "serialization_file/vector_large.xml");
+    deserialize_xml(x2, "serialization_file/vector_large.xml", ValidateIndices);
+    assert(x1 == x2);
+    std::ofstream("serialization_file/vector_bad_index.xml") << "<serialization><std_vector><size>2</size>"
+        "<index_0><value>1</value></index_0><index_2><value>2</value></index_2></std_vector></serialization>";
+    rejected = false;
+    try {
+        deserialize_xml(x2, "serialization_file/vector_bad_index.xml", ValidateIndices);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    deserialize_xml(x2, "serialization_file/vector_bad_index.xml");
+    assert((x2 == std::vector<int>{1, 2}));
+    std::cout << "xml::test<validate indices> passed." << std::endl;
+
+    std::map<int, std::vector<int>> x3 = {{1, {1, 2, 3}}, {2, {4, 5, 6}}}, x4;
+    serialize_xml(x3, "serialization_file/map_vector_compact.xml", Compact);
+    deserialize_xml(x4, "serialization_file/map_vector_compact.xml");
+    assert(x3 == x4);
+    std::map<std::string, std::vector<person>> x5 = m5;
+    x5["Carol"] = {{"", 0, {}}};
+    serialize_xml(x5, "serialization_file/map_person_compact.xml", Compact);
+    m6.clear();
+    deserialize_xml(m6, "serialization_file/map_person_compact.xml", ValidateIndices);
+    assert(x5 == m6);
+    serialize_xml(x5, "serialization_file/map_person_compact.txt", Compact | Base64);
+    m6.clear();
+    deserialize_xml(m6, "serialization_file/map_person_compact.txt", true);
+    assert(x5 == m6);
+    std::cout << "xml::test<compact> passed." << std::endl;
+
+    std::vector<double> doubles1 = {0.1 + 0.2, 1.0 / 3, 1e-300, std::numeric_limits<double>::max()}, doubles2;
+    serialize_xml(doubles1, "serialization_file/vector_double.xml");
+    deserialize_xml(doubles2, "serialization_file/vector_double.xml");
+    assert(doubles1 == doubles2);
+    std::vector<long double> longDoubles1 = {1.0L / 3, std::numeric_limits<long double>::min()}, longDoubles2;
+    serialize_xml(longDoubles1, "serialization_file/vector_long_double.xml", Compact);
+    deserialize_xml(longDoubles2, "serialization_file/vector_long_double.xml");
+    assert(longDoubles1 == longDoubles2);
+    std::map<long long, std::pair<bool, char>> flags1 = {{std::numeric_limits<long long>::min(), {true, -5}}, {std::numeric_limits<long long>::max(), {false, 'x'}}}, flags2;
+    serialize_xml(flags1, "serialization_file/map_flags.xml");
+    deserialize_xml(flags2, "serialization_file/map_flags.xml");
+    assert(flags1 == flags2);
+    std::cout << "xml::test<numbers> passed." << std::endl;
+
+    auto readFile = [](const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    serialize_xml(m5, "serialization_file/map_person_streaming.xml", Streaming);
+    assert(readFile("serialization_file/map_person_streaming.xml") == readFile("serialization_file/map_person.xml"));
+    serialize_xml(x5, "serialization_file/map_person_compact_streaming.xml", Streaming | Compact);
+    assert(readFile("serialization_file/map_person_compact_streaming.xml") == readFile("serialization_file/map_person_compact.xml"));
+    serialize_xml(flags1, "serialization_file/map_flags_streaming.txt", Streaming | Base64);
+    flags2.clear();
+    deserialize_xml(flags2, "serialization_file/map_flags_streaming.txt", true);
+    assert(flags1 == flags2);
+    std::cout << "xml::test<streaming> passed." << std::endl;
+
+    m6.clear();
+    deserialize_xml(m6, "serialization_file/map_person.xml", Streaming);
+    assert(m5 == m6);
+    m6.clear();
+    deserialize_xml(m6, "serialization_file/map_person_compact.xml", Streaming | ValidateIndices);
+    assert(x5 == m6);
+    x2.clear();
+    deserialize_xml(x2, "serialization_file/vector_large.xml", Streaming | ValidateIndices);
+    assert(x1 == x2);
+    flags2.clear();
+    deserialize_xml(flags2, "serialization_file/map_flags_streaming.txt", Streaming | Base64);
+    assert(flags1 == flags2);
+    std::ofstream("serialization_file/vector_string_markup.xml") << "<?xml version=\"1.0\"?>\n<!DOCTYPE serialization>\n"
+        "<!-- hand-written -->\n<serialization format='compact'><std_vector><e v=\"a &lt;b&gt; &amp; &quot;c&quot;\"/>"
+        "<e><v>&#x41;&#66;</v></e><e><v><![CDATA[<raw>]]></v></e><e v=\"\"/></std_vector></serialization>\n";
+    std::vector<std::string> strings1 = {"a <b> & \"c\"", "AB", "<raw>", ""}, strings2;
+    deserialize_xml(strings2, "serialization_file/vector_string_markup.xml", Streaming);
+    assert(strings1 == strings2);
+    std::cout << "xml::test<pull parser> passed." << std::endl;
+
+    std::map<std::string, std::vector<double>> readings1 = {{"humidity", {0.5, 0.25, -1e-9}}, {"pressure", {}}}, readings2;
+    serialize_xml(readings1, "serialization_file/map_readings_packed.xml", PackedText);
+    deserialize_xml(readings2, "serialization_file/map_readings_packed.xml");
+    assert(readings1 == readings2);
+    serialize_xml(readings1, "serialization_file/map_readings_base64.xml", PackedBase64 | Compact | Streaming);
+    readings2.clear();
+    deserialize_xml(readings2, "serialization_file/map_readings_base64.xml", Streaming);
+    assert(readings1 == readings2);
+    readings2.clear();
+    deserialize_xml(readings2, "serialization_file/map_readings_base64.xml");
+    assert(readings1 == readings2);
+    std::set<int> s7 = {-3, 1, 4}, s8;
+    serialize_xml(s7, "serialization_file/set_packed.xml", PackedText | Streaming);
+    deserialize_xml(s8, "serialization_file/set_packed.xml", Streaming);
+    assert(s7 == s8);
+    std::cout << "xml::test<packed> passed." << std::endl;
+
+    char tagBuffer[indexTagBufferSize];
+    const char* tag = indexTag(42, tagBuffer);
+    assert(std::string(tag) == "index_42" && tag != tagBuffer && indexTag(42, tagBuffer) == tag);
+    assert(std::string(indexTag(internedIndexLimit + 1, tagBuffer)) == "index_" + std::to_string(internedIndexLimit + 1));
+    serialize_xml(x1, "serialization_file/vector_large_streaming.xml", Streaming);
+    assert(readFile("serialization_file/vector_large_streaming.xml") == readFile("serialization_file/vector_large.xml"));
+    std::cout << "xml::test<interned tags> passed." << std::endl;
+
+    XmlContext& context = XmlContext::local();
+    assert(&context == &XmlContext::local());
+    for (int i = 0; i < 3; ++i) {
+        std::map<std::string, std::vector<person>> x6;
+        deserialize_xml(x6, serialize_xml(x5, context, Compact), context);
+        assert(x5 == x6);
+        std::vector<int> x7;
+        deserialize_xml(x7, serialize_xml(x1, context), context, Streaming);
+        assert(x1 == x7);
+    }
+    serialize_xml(x5, "serialization_file/map_person_context.xml", Base64, context);
+    std::map<std::string, std::vector<person>> x8;
+    deserialize_xml(x8, "serialization_file/map_person_context.xml", Base64, context);
+    assert(x5 == x8);
+    std::cout << "xml::test<context> passed." << std::endl;
+
+    std::vector<reading> hand1 = {{"kitchen", {21.5}, 1}, {"attic", {-3.25}, 2}}, hand2;
+    for (XmlMode handMode : {XmlDefault, Compact}) {
+        serialize_xml(hand1, "serialization_file/vector_reading.xml", handMode);
+        serialize_xml(hand1, "serialization_file/vector_reading_streaming.xml", handMode | Streaming);
+        assert(readFile("serialization_file/vector_reading_streaming.xml") == readFile("serialization_file/vector_reading.xml"));
+        hand2.clear();
+        deserialize_xml(hand2, "serialization_file/vector_reading_streaming.xml", handMode);
+        assert(hand1 == hand2);
+        bool handRejected = false;
+        try {
+            deserialize_xml(hand2, "serialization_file/vector_reading_streaming.xml", handMode | Streaming);
+        } catch (const std::runtime_error&) {
+            handRejected = true;
+        }
+        assert(handRejected);
+    }
+    std::cout << "xml::test<hand-written members> passed." << std::endl;
+
+    // A file that ends on a page boundary, so the NUL after the mapped data comes from the extra page.
+    std::string mappedXml = serialize_xml(x3, context, Compact);
+    mappedXml.append(65536 - mappedXml.size(), ' ');
+    {
+        std::ofstream file("serialization_file/map_vector_mapped.xml", std::ios::binary);
+        file << mappedXml;
+    }
+    std::map<int, std::vector<int>> x9;
+    deserialize_xml(x9, "serialization_file/map_vector_mapped.xml", XmlDefault, context);
+    assert(x3 == x9);
+    assert(readFile("serialization_file/map_vector_mapped.xml") == mappedXml);
+    MappedFile mapped("serialization_file/map_vector_mapped.xml", true);
+    assert(mapped.size() == 65536 && mapped.writableData()[mapped.size()] == '\0');
+    mapped.writableData()[0] = 'x';
+    assert(readFile("serialization_file/map_vector_mapped.xml") == mappedXml);
+    std::cout << "xml::test<mapped file> passed." << std::endl;
+
     std::cout << "----------------------" << std::endl;
     std::cout << "All bin::tests passed." << std::endl;
 
@@ -1749,6 +1749,15 @@ public:
     */
     XMLError Parse( const char* xml, size_t nBytes=static_cast<size_t>(-1) );
 
+    /**
+    	Parse an XML document in the caller's buffer without copying it.
+    	'xml' must be writable, since parsing modifies it, and
+    	xml[nBytes] must be a null terminator. The buffer is not
+    	freed by the document and must outlive it, or the next
+    	call to Clear().
+    */
+    XMLError ParseInPlace( char* xml, size_t nBytes );
+
     /**
     	Load an XML file from disk.
     	Returns XML_SUCCESS (0) on success, or
@@ -1836,7 +1845,7 @@ public:
     	this Document. The memory for the Element
     	is managed by the Document.
     */
-    XMLElement* NewElement( const char* name );
+    XMLElement* NewElement( const char* name, bool staticMem=false );
     /**
     	Create a new Comment associated with
     	this Document. The memory for the Comment
@@ -1938,6 +1947,7 @@ private:
     mutable StrPair	_errorStr;
     int             _errorLineNum;
     char*			_charBuffer;
+    bool			_charBufferOwned;
     int				_parseCurLineNum;
 	int				_parsingDepth;
 	// Memory tracking does add some overhead.
@@ -0,0 +1,371 @@
+#ifndef _XML_PULL_PARSER_HPP_
+#define _XML_PULL_PARSER_HPP_
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+/*
+* A pull parser for the XML written by xmlSerialization.
+* Instead of building a DOM it hands out one event at a time (start tag, end tag, text), reading the input
+* through a fixed-size buffer, so memory use depends on the nesting depth and not on the document size.
+* Comments, the prolog (<?xml ...?> and <!DOCTYPE ...>), CDATA sections, self-closing tags and the
+* predefined and numeric character entities are handled. Whitespace-only text is skipped.
+*/
+namespace xmlSerialization {
+
+    class XMLPullParser {
+    public:
+        enum Event { StartElement, EndElement, Text, EndDocument };
+
+        static constexpr size_t bufferSize = 1 << 16;
+
+        // Read from a file, bufferSize bytes at a time. The file stays owned by the caller.
+        explicit XMLPullParser(FILE* file) : file_(file), buffer_(bufferSize) {
+            current_ = end_ = buffer_.data();
+        }
+
+        // Read from bytes in memory, e.g. a MappedFile.
+        XMLPullParser(const char* data, size_t size) : current_(data), end_(data + size) {}
+
+        XMLPullParser(const XMLPullParser&) = delete;
+        XMLPullParser& operator=(const XMLPullParser&) = delete;
+
+        // Advance to the next event.
+        Event next() {
+            attributes_.clear();
+            if (pendingEnd_) {
+                pendingEnd_ = false;
+                return EndElement;
+            }
+            while (true) {
+                int c = get();
+                if (c == EOF) {
+                    if (depth_ != 0) {
+                        throw std::runtime_error("Unexpected end of file!");
+                    }
+                    return EndDocument;
+                }
+                if (c != '<') {
+                    text_.clear();
+                    unget(c);
+                    readText();
+                    if (text_.find_first_not_of(" \t\r\n") != std::string::npos) {
+                        return Text;
+                    }
+                    continue;
+                }
+                c = get();
+                if (c == '?') {
+                    skipPast("?>");
+                } else if (c == '!') {
+                    if (startsWith("--")) {
+                        skipPast("-->");
+                    } else if (startsWith("[CDATA[")) {
+                        text_.clear();
+                        readUntil("]]>", text_);
+                        return Text;
+                    } else {
+                        skipDeclaration();
+                    }
+                } else if (c == '/') {
+                    readName(name_);
+                    skipSpace();
+                    expect('>');
+                    if (depth_ == 0 || open_[depth_ - 1] != name_) {
+                        throw std::runtime_error("Mismatched end tag: " + name_);
+                    }
+                    --depth_;
+                    return EndElement;
+                } else {
+                    unget(c);
+                    readStartTag();
+                    return StartElement;
+                }
+            }
+        }
+
+        // Name of the element of the last StartElement or EndElement event.
+        const std::string& name() const {
+            return name_;
+        }
+
+        // Content of the last Text event, with entities decoded.
+        const std::string& text() const {
+            return text_;
+        }
+
+        // Attribute of the element of the last StartElement event, or nullptr.
+        const char* attribute(const char* name) const {
+            for (const auto& attribute : attributes_) {
+                if (attribute.first == name) {
+                    return attribute.second.c_str();
+                }
+            }
+            return nullptr;
+        }
+
+        // Remove an attribute once it has been read, so a later lookup does not see it again.
+        void removeAttribute(const char* name) {
+            for (auto it = attributes_.begin(); it != attributes_.end(); ++it) {
+                if (it->first == name) {
+                    attributes_.erase(it);
+                    return;
+                }
+            }
+        }
+
+        void setUserData(void* userData) {
+            userData_ = userData;
+        }
+
+        void* userData() const {
+            return userData_;
+        }
+
+    private:
+        int get() {
+            if (current_ == end_ && !refill()) {
+                return EOF;
+            }
+            return static_cast<unsigned char>(*current_++);
+        }
+
+        void unget(int c) {
+            if (c != EOF) {
+                --current_;
+            }
+        }
+
+        bool refill() {
+            if (file_ == nullptr) {
+                return false;
+            }
+            // Keep the last byte, so one get() can always be undone.
+            size_t kept = current_ > buffer_.data() ? 1 : 0;
+            if (kept) {
+                buffer_[0] = current_[-1];
+            }
+            size_t count = std::fread(buffer_.data() + kept, 1, buffer_.size() - kept, file_);
+            current_ = buffer_.data() + kept;
+            end_ = current_ + count;
+            return count > 0;
+        }
+
+        int getChecked() {
+            int c = get();
+            if (c == EOF) {
+                throw std::runtime_error("Unexpected end of file!");
+            }
+            return c;
+        }
+
+        void expect(char expected) {
+            if (getChecked() != expected) {
+                throw std::runtime_error(std::string("Expected '") + expected + "' in XML!");
+            }
+        }
+
+        static bool isSpace(int c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        void skipSpace() {
+            int c;
+            do {
+                c = get();
+            } while (isSpace(c));
+            unget(c);
+        }
+
+        // Consume `prefix` if the input continues with it. Only called with prefixes whose first
+        // character cannot start anything else at that point, so a mismatch is an error.
+        bool startsWith(const char* prefix) {
+            int c = get();
+            if (c != prefix[0]) {
+                unget(c);
+                return false;
+            }
+            for (const char* p = prefix + 1; *p; ++p) {
+                if (getChecked() != *p) {
+                    throw std::runtime_error("Malformed XML markup!");
+                }
+            }
+            return true;
+        }
+
+        void readUntil(const char* terminator, std::string& out) {
+            size_t length = std::strlen(terminator);
+            while (true) {
+                out += static_cast<char>(getChecked());
+                if (out.size() >= length && out.compare(out.size() - length, length, terminator) == 0) {
+                    out.resize(out.size() - length);
+                    return;
+                }
+            }
+        }
+
+        void skipPast(const char* terminator) {
+            scratch_.clear();
+            readUntil(terminator, scratch_);
+        }
+
+        // <!DOCTYPE ...>, possibly with an internal subset in brackets.
+        void skipDeclaration() {
+            int depth = 0;
+            while (true) {
+                int c = getChecked();
+                if (c == '[') {
+                    ++depth;
+                } else if (c == ']') {
+                    --depth;
+                } else if (c == '>' && depth <= 0) {
+                    return;
+                }
+            }
+        }
+
+        void readName(std::string& out) {
+            out.clear();
+            while (true) {
+                int c = get();
+                if (c == EOF || isSpace(c) || c == '>' || c == '/' || c == '=') {
+                    unget(c);
+                    break;
+                }
+                out += static_cast<char>(c);
+            }
+            if (out.empty()) {
+                throw std::runtime_error("Malformed XML markup!");
+            }
+        }
+
+        void readStartTag() {
+            readName(name_);
+            while (true) {
+                skipSpace();
+                int c = getChecked();
+                if (c == '>') {
+                    break;
+                }
+                if (c == '/') {
+                    expect('>');
+                    pendingEnd_ = true;
+                    break;
+                }
+                unget(c);
+                attributes_.emplace_back();
+                readName(attributes_.back().first);
+                skipSpace();
+                expect('=');
+                skipSpace();
+                int quote = getChecked();
+                if (quote != '"' && quote != '\'') {
+                    throw std::runtime_error("Malformed XML attribute!");
+                }
+                std::string& value = attributes_.back().second;
+                for (c = getChecked(); c != quote; c = getChecked()) {
+                    if (c == '&') {
+                        readEntity(value);
+                    } else {
+                        value += static_cast<char>(c);
+                    }
+                }
+            }
+            if (!pendingEnd_) {
+                // The names of open elements keep their capacity, so steady-state parsing does not allocate.
+                if (open_.size() == depth_) {
+                    open_.emplace_back();
+                }
+                open_[depth_++] = name_;
+            }
+        }
+
+        void readText() {
+            while (true) {
+                int c = get();
+                if (c == EOF || c == '<') {
+                    unget(c);
+                    return;
+                }
+                if (c == '&') {
+                    readEntity(text_);
+                } else {
+                    text_ += static_cast<char>(c);
+                }
+            }
+        }
+
+        // The part of an entity reference after '&', appended to `out` decoded.
+        void readEntity(std::string& out) {
+            char entity[16];
+            size_t length = 0;
+            for (int c = getChecked(); c != ';'; c = getChecked()) {
+                if (length + 1 == sizeof(entity)) {
+                    throw std::runtime_error("Malformed XML entity!");
+                }
+                entity[length++] = static_cast<char>(c);
+            }
+            entity[length] = '\0';
+            if (entity[0] == '#') {
+                bool hex = entity[1] == 'x' || entity[1] == 'X';
+                char* end = nullptr;
+                unsigned long code = std::strtoul(entity + (hex ? 2 : 1), &end, hex ? 16 : 10);
+                if (end == entity + (hex ? 2 : 1) || *end != '\0' || code > 0x10ffff) {
+                    throw std::runtime_error("Malformed XML entity!");
+                }
+                appendUtf8(out, code);
+            } else if (std::strcmp(entity, "lt") == 0) {
+                out += '<';
+            } else if (std::strcmp(entity, "gt") == 0) {
+                out += '>';
+            } else if (std::strcmp(entity, "amp") == 0) {
+                out += '&';
+            } else if (std::strcmp(entity, "quot") == 0) {
+                out += '"';
+            } else if (std::strcmp(entity, "apos") == 0) {
+                out += '\'';
+            } else {
+                throw std::runtime_error("Unknown XML entity!");
+            }
+        }
+
+        static void appendUtf8(std::string& out, unsigned long code) {
+            if (code < 0x80) {
+                out += static_cast<char>(code);
+            } else if (code < 0x800) {
+                out += static_cast<char>(0xc0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3f));
+            } else if (code < 0x10000) {
+                out += static_cast<char>(0xe0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code & 0x3f));
+            } else {
+                out += static_cast<char>(0xf0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code & 0x3f));
+            }
+        }
+
+        FILE* file_ = nullptr;
+        std::vector<char> buffer_;
+        const char* current_ = nullptr;
+        const char* end_ = nullptr;
+        std::string name_;
+        std::string text_;
+        std::string scratch_;
+        std::vector<std::pair<std::string, std::string>> attributes_;
+        std::vector<std::string> open_;
+        size_t depth_ = 0;
+        bool pendingEnd_ = false;
+        void* userData_ = nullptr;
+    };
+
+}
+
+#endif // _XML_PULL_PARSER_HPP_
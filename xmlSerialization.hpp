@@ -10,13 +10,57 @@
 #include <string>
 #include <type_traits>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <charconv>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <optional>
 #include "thirdparty/tinyxml2.h"
 #include "mybase64.hpp"
+#include "xmlPullParser.hpp"
+#include "mappedFile.hpp"
 
 using namespace tinyxml2;
 
 namespace xmlSerialization {
 
+    // Options for serialize_xml / deserialize_xml, combined with `|`.
+    enum XmlMode : unsigned {
+        XmlDefault = 0,
+        Base64 = 1u << 0,               // base64-encode the whole document
+        ValidateIndices = 1u << 1,      // on load, check that container items are index_0, index_1, ... and match <size>
+        Compact = 1u << 2,              // compact dialect: <e> items, no <size>, scalars as attributes, no indentation
+        Streaming = 1u << 3,            // write and read documents element by element, without building a DOM
+        PackedText = 1u << 4,           // write sequences of numbers as one element of space-separated text
+        PackedBase64 = 1u << 5,         // write sequences of numbers as one element of base64-encoded raw bytes
+    };
+
+    constexpr XmlMode operator|(XmlMode a, XmlMode b) {
+        return static_cast<XmlMode>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    // The mode of the current call travels with the document, so the overloads keep their (value, doc, parent) signature.
+    inline void setModeOf(XMLDocument& doc, XmlMode mode) {
+        doc.SetUserData(reinterpret_cast<void*>(static_cast<uintptr_t>(mode)));
+    }
+
+    inline XmlMode modeOf(const XMLDocument& doc) {
+        return static_cast<XmlMode>(reinterpret_cast<uintptr_t>(doc.GetUserData()));
+    }
+
+    inline void setModeOf(XMLPullParser& parser, XmlMode mode) {
+        parser.setUserData(reinterpret_cast<void*>(static_cast<uintptr_t>(mode)));
+    }
+
+    inline XmlMode modeOf(const XMLPullParser& parser) {
+        return static_cast<XmlMode>(reinterpret_cast<uintptr_t>(parser.userData()));
+    }
+
     // Register functions
     template <typename Func, typename... Members>
     void registerConstFunction(const Func& func, const Members&... members) {
@@ -27,34 +71,153 @@ namespace xmlSerialization {
         (func(members), ...);
     }
 
+    // The compact dialect writes a scalar as attribute v of its parent while the parent is still empty,
+    // otherwise as a <v> child. Reading consumes each scalar, so the next one of the same parent comes first.
+    inline void writeScalar_xml(XMLDocument& doc, XMLElement* parent, const char* text) {
+        if (parent->FirstChild() == nullptr && parent->FindAttribute("v") == nullptr) {
+            parent->SetAttribute("v", text);
+            return;
+        }
+        XMLElement* element = doc.NewElement("v", true);
+        element->SetText(text);
+        parent->InsertEndChild(element);
+    }
+
+    template<typename Read>
+    void readScalar_xml(XMLElement* parent, Read read) {
+        if (const XMLAttribute* attribute = parent->FindAttribute("v")) {
+            read(attribute->Value());
+            parent->DeleteAttribute("v");
+            return;
+        }
+        XMLElement* element = parent->FirstChildElement("v");
+        if (element == nullptr) {
+            throw std::runtime_error("Missing value!");
+        }
+        const char* text = element->GetText();
+        read(text != nullptr ? text : "");
+        parent->DeleteChild(element);
+    }
+
+    // Numbers are written with std::to_chars (the shortest form that reads back exactly, for floating point)
+    // and read with std::from_chars, so neither depends on the locale or allocates. bool is written as true / false.
+    constexpr size_t numberBufferSize = 128;
+
+    template<typename T>
+    const char* formatNumber(T value, char (&buffer)[numberBufferSize]) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? "true" : "false";
+        } else {
+            std::to_chars_result result = std::to_chars(buffer, buffer + numberBufferSize - 1, value);
+            *result.ptr = '\0';
+            return buffer;
+        }
+    }
+
+    template<typename T>
+    void parseNumber(const char* text, T& value) {
+        if (text == nullptr) {
+            throw std::runtime_error("Invalid number!");
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            if (std::strcmp(text, "true") == 0 || std::strcmp(text, "1") == 0) {
+                value = true;
+            } else if (std::strcmp(text, "false") == 0 || std::strcmp(text, "0") == 0) {
+                value = false;
+            } else {
+                throw std::runtime_error("Invalid number!");
+            }
+        } else {
+            const char* end = text + std::strlen(text);
+            std::from_chars_result result = std::from_chars(text, end, value);
+            if (result.ec != std::errc() || result.ptr != end) {
+                throw std::runtime_error("Invalid number!");
+            }
+        }
+    }
+
+    // Element names. The fixed vocabulary (std_vector, value, ...) is made of string literals, and the names of
+    // the first internedIndexLimit container items are interned once per process, so tinyxml2 can keep pointers
+    // to them (NewElement(name, true)) instead of copying every name. Later items are formatted into a buffer.
+    constexpr size_t internedIndexLimit = 1 << 16;
+    constexpr size_t indexTagBufferSize = 32;
+
+    inline const char* formatIndexTag(size_t index, char (&buffer)[indexTagBufferSize]) {
+        std::memcpy(buffer, "index_", 6);
+        *std::to_chars(buffer + 6, buffer + indexTagBufferSize - 1, index).ptr = '\0';
+        return buffer;
+    }
+
+    // The name index_<index>: interned (static, never freed) below internedIndexLimit, otherwise written to buffer.
+    inline const char* indexTag(size_t index, char (&buffer)[indexTagBufferSize]) {
+        if (index >= internedIndexLimit) {
+            return formatIndexTag(index, buffer);
+        }
+        thread_local std::vector<const char*> cache;
+        if (index >= cache.size()) {
+            static std::mutex mutex;
+            static std::deque<std::string>* names = new std::deque<std::string>();
+            std::lock_guard<std::mutex> lock(mutex);
+            while (names->size() <= index) {
+                names->emplace_back(formatIndexTag(names->size(), buffer));
+            }
+            for (size_t i = cache.size(); i < names->size(); ++i) {
+                cache.push_back((*names)[i].c_str());
+            }
+        }
+        return cache[index];
+    }
+
     // Handling arithmetic types
     template<typename T>
     typename std::enable_if_t<std::is_arithmetic_v<T>, void>
     serialize_xml_(const T& value, XMLDocument& doc, XMLElement* parent) {
-        XMLElement* element = doc.NewElement("value");
-        element->SetText(value);
+        char buffer[numberBufferSize];
+        const char* text = formatNumber(value, buffer);
+        if (modeOf(doc) & Compact) {
+            writeScalar_xml(doc, parent, text);
+            return;
+        }
+        XMLElement* element = doc.NewElement("value", true);
+        element->SetText(text);
         parent->InsertEndChild(element);
     }
 
     template<typename T>
     typename std::enable_if_t<std::is_arithmetic_v<T>, void>
     deserialize_xml_(T& value, XMLDocument& doc, XMLElement* parent) {
+        if (modeOf(doc) & Compact) {
+            readScalar_xml(parent, [&](const char* text) {
+                parseNumber(text, value);
+            });
+            return;
+        }
         XMLElement* element = parent->FirstChildElement("value");
-        std::string str = element->GetText();
-        std::stringstream ss(str);
-        ss >> value;
+        parseNumber(element->GetText(), value);
     }
 
     // Handling std::string
     void serialize_xml_(const std::string& str, XMLDocument& doc, XMLElement* parent) {
-        XMLElement* element = doc.NewElement("std_string");
+        if (modeOf(doc) & Compact) {
+            writeScalar_xml(doc, parent, str.c_str());
+            return;
+        }
+        XMLElement* element = doc.NewElement("std_string", true);
         element->SetText(str.c_str());
         parent->InsertEndChild(element);
     }
 
     void deserialize_xml_(std::string& str, XMLDocument& doc, XMLElement* parent) {
+        if (modeOf(doc) & Compact) {
+            readScalar_xml(parent, [&](const char* text) {
+                str = text;
+            });
+            return;
+        }
         XMLElement* element = parent->FirstChildElement("std_string");
-        str = element->GetText();
+        // An empty string is written as an element without text.
+        const char* text = element->GetText();
+        str = text != nullptr ? text : "";
     }
 
     // Some declaration
@@ -118,12 +281,17 @@ namespace xmlSerialization {
     // Handling std::pair
     template<typename T1, typename T2>
     void serialize_xml_(const std::pair<T1, T2>& pair, XMLDocument& doc, XMLElement* parent) {
-        XMLElement* element = doc.NewElement("std_pair");
+        if (modeOf(doc) & Compact) {
+            serialize_xml_(pair.first, doc, parent);
+            serialize_xml_(pair.second, doc, parent);
+            return;
+        }
+        XMLElement* element = doc.NewElement("std_pair", true);
         parent->InsertEndChild(element);
-        XMLElement* elementFirst = doc.NewElement("first");
+        XMLElement* elementFirst = doc.NewElement("first", true);
         element->InsertEndChild(elementFirst);
         serialize_xml_(pair.first, doc, elementFirst);
-        XMLElement* elementSecond = doc.NewElement("second");
+        XMLElement* elementSecond = doc.NewElement("second", true);
         element->InsertEndChild(elementSecond);
         serialize_xml_(pair.second, doc, elementSecond);
 
@@ -131,6 +299,11 @@ namespace xmlSerialization {
 
     template<typename T1, typename T2>
     void deserialize_xml_(std::pair<T1, T2>& pair, XMLDocument& doc, XMLElement* parent) {
+        if (modeOf(doc) & Compact) {
+            deserialize_xml_(pair.first, doc, parent);
+            deserialize_xml_(pair.second, doc, parent);
+            return;
+        }
         XMLElement* element = parent->FirstChildElement("std_pair");
         XMLElement* elementFirst = element->FirstChildElement("first");
         deserialize_xml_(pair.first, doc, elementFirst);
@@ -151,50 +324,673 @@ namespace xmlSerialization {
         value.deserialize_xml_(doc, parent);
     }
 
+    // Packed numeric sequences: a vector, list or set of numbers (bool excepted) as one element whose attribute
+    // packed is "text" (the numbers separated by spaces) or "base64" (the raw bytes, in native byte order).
+    // The attribute marks the element, so packed sequences are read without any option.
+    template<typename T>
+    constexpr bool isPackedNumber_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    // The packing chosen by the mode, or nullptr to write items.
+    inline const char* packingOf(XmlMode mode) {
+        if (mode & PackedBase64) {
+            return "base64";
+        }
+        if (mode & PackedText) {
+            return "text";
+        }
+        return nullptr;
+    }
+
+    template<typename Container>
+    std::string packNumbers_xml(const Container& container, const char* packing) {
+        using T = typename Container::value_type;
+        std::string packed;
+        if (std::strcmp(packing, "base64") == 0) {
+            std::vector<T> values(container.begin(), container.end());
+            return base64_encode(reinterpret_cast<const unsigned char*>(values.data()), values.size() * sizeof(T));
+        }
+        char buffer[numberBufferSize];
+        for (const T& value : container) {
+            if (!packed.empty()) {
+                packed += ' ';
+            }
+            packed += formatNumber(value, buffer);
+        }
+        return packed;
+    }
+
+    template<typename Container>
+    void unpackNumbers_xml(Container& container, bool base64, const char* text) {
+        using T = typename Container::value_type;
+        if (text == nullptr) {
+            return;
+        }
+        if (base64) {
+            std::string bytes = base64_decode(text);
+            if (bytes.size() % sizeof(T) != 0) {
+                throw std::runtime_error("Invalid packed data!");
+            }
+            for (size_t offset = 0; offset < bytes.size(); offset += sizeof(T)) {
+                T value;
+                std::memcpy(&value, bytes.data() + offset, sizeof(T));
+                container.insert(container.end(), value);
+            }
+            return;
+        }
+        const char* end = text + std::strlen(text);
+        while (true) {
+            while (text != end && (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n')) {
+                ++text;
+            }
+            if (text == end) {
+                return;
+            }
+            T value;
+            std::from_chars_result result = std::from_chars(text, end, value);
+            if (result.ec != std::errc() || (result.ptr != end && *result.ptr != ' ' && *result.ptr != '\t'
+                    && *result.ptr != '\r' && *result.ptr != '\n')) {
+                throw std::runtime_error("Invalid number!");
+            }
+            container.insert(container.end(), value);
+            text = result.ptr;
+        }
+    }
+
     // Serialization and deserialization methods for containers
+    // containerName is one of the fixed names, so the element keeps a pointer to it.
     template<typename Container>
     void serializeContainer_xml(const Container& container, XMLDocument& doc, XMLElement* parent, const char* containerName) {
-        XMLElement* containerElement = doc.NewElement(containerName);
+        XMLElement* containerElement = doc.NewElement(containerName, true);
         parent->InsertEndChild(containerElement);
-        XMLElement* sizeElement = doc.NewElement("size");
-        sizeElement->SetText(std::to_string(container.size()).c_str());
+        if constexpr (isPackedNumber_v<typename Container::value_type>) {
+            if (const char* packing = packingOf(modeOf(doc))) {
+                containerElement->SetAttribute("packed", packing);
+                containerElement->SetText(packNumbers_xml(container, packing).c_str());
+                return;
+            }
+        }
+        if (modeOf(doc) & Compact) {
+            for (const auto& element : container) {
+                XMLElement* item = doc.NewElement("e", true);
+                containerElement->InsertEndChild(item);
+                serialize_xml_(element, doc, item);
+            }
+            return;
+        }
+        char buffer[numberBufferSize];
+        XMLElement* sizeElement = doc.NewElement("size", true);
+        sizeElement->SetText(formatNumber(container.size(), buffer));
         containerElement->InsertEndChild(sizeElement);
-        int index = 0;
+        char name[indexTagBufferSize];
+        size_t index = 0;
         for (const auto& element : container) {
-            XMLElement* element_ = doc.NewElement(("index_" + std::to_string(index)).c_str());
+            const char* tag = indexTag(index, name);
+            XMLElement* element_ = doc.NewElement(tag, tag != name);
             containerElement->InsertEndChild(element_);
             serialize_xml_(element, doc, element_);
             ++index;
         }
     }
 
-    template<typename Container>
-    void deserializeContainer_xml(Container& container, XMLDocument& doc, XMLElement* parent, const char* containerName) {
-        XMLElement* containerElement = parent->FirstChildElement(containerName); 
+    // The items of a container element, in document order: the siblings following <size>.
+    // Walking the siblings once keeps decoding linear; with ValidateIndices the item names and count are checked too.
+    // In the compact dialect the items are all <e> children, and the container is consumed once read.
+    template<typename ReadItem>
+    void forEachItem_xml(XMLDocument& doc, XMLElement* containerElement, ReadItem readItem) {
+        if (modeOf(doc) & Compact) {
+            bool validate = modeOf(doc) & ValidateIndices;
+            for (XMLElement* item = containerElement->FirstChildElement(); item != nullptr; item = item->NextSiblingElement()) {
+                if (validate && std::strcmp(item->Name(), "e") != 0) {
+                    throw std::runtime_error("Invalid container index!");
+                }
+                readItem(item);
+            }
+            containerElement->Parent()->DeleteChild(containerElement);
+            return;
+        }
         XMLElement* sizeElement = containerElement->FirstChildElement("size");
-        unsigned int size;
+        unsigned int size = 0;
         sizeElement->QueryUnsignedText(&size);
+        bool validate = modeOf(doc) & ValidateIndices;
+        char name[indexTagBufferSize];
+        XMLElement* item = sizeElement->NextSiblingElement();
+        size_t i = 0;
+        for (; item != nullptr && i < size; item = item->NextSiblingElement(), ++i) {
+            if (validate) {
+                if (std::strcmp(item->Name(), indexTag(i, name)) != 0) {
+                    throw std::runtime_error("Invalid container index!");
+                }
+            }
+            readItem(item);
+        }
+        if (validate && (i != size || item != nullptr)) {
+            throw std::runtime_error("Container size does not match!");
+        }
+    }
+
+    template<typename Container>
+    void deserializeContainer_xml(Container& container, XMLDocument& doc, XMLElement* parent, const char* containerName) {
+        XMLElement* containerElement = parent->FirstChildElement(containerName);
         container.clear();
-        for (size_t i = 0; i < size; ++i) {
-            typename Container::value_type element;
-            deserialize_xml_(element, doc, containerElement->FirstChildElement(("index_" + std::to_string(i)).c_str()));
-            container.insert(container.end(), element);
+        if constexpr (isPackedNumber_v<typename Container::value_type>) {
+            if (const char* packing = containerElement->Attribute("packed")) {
+                unpackNumbers_xml(container, std::strcmp(packing, "base64") == 0, containerElement->GetText());
+                if (modeOf(doc) & Compact) {
+                    parent->DeleteChild(containerElement);
+                }
+                return;
+            }
         }
+        // Every overload overwrites the whole value it reads, so one scratch element serves all items
+        // and is moved, not copied, into the container.
+        typename Container::value_type element{};
+        forEachItem_xml(doc, containerElement, [&](XMLElement* item) {
+            deserialize_xml_(element, doc, item);
+            container.insert(container.end(), std::move(element));
+        });
     }
 
     // special case for std::map, because key is CONST.
     template<typename Value, typename Key>
     void deserializeContainer_xml(std::map<Key, Value>& map, XMLDocument& doc, XMLElement* parent) {
         XMLElement* containerElement = parent->FirstChildElement("std_map");
-        XMLElement* sizeElement = containerElement->FirstChildElement("size");
-        unsigned int size;
-        sizeElement->QueryUnsignedText(&size);
         map.clear();
-        for (size_t i = 0; i < size; ++i) {
-            std::pair<Key, Value> element; 
-            deserialize_xml_(element, doc, containerElement->FirstChildElement(("index_" + std::to_string(i)).c_str()));
-            map.insert(map.end(), element);
+        std::pair<Key, Value> element{};
+        forEachItem_xml(doc, containerElement, [&](XMLElement* item) {
+            deserialize_xml_(element, doc, item);
+            map.emplace_hint(map.end(), std::move(element));
+        });
+    }
+
+    // Streaming output: the same documents as the DOM overloads produce, printed element by element through an
+    // XMLPrinter as the value is traversed, so memory use does not grow with the document.
+    class XMLStreamWriter {
+    public:
+        // With a file the output goes straight to it; without one it collects in the printer's buffer (see CStr).
+        XMLStreamWriter(FILE* file, XmlMode mode) : printer_(file, mode & Compact), mode_(mode), compact_(mode & Compact) {}
+
+        XmlMode mode() const {
+            return mode_;
         }
+
+        void openElement(const char* name) {
+            printer_.OpenElement(name, compact_);
+            valueFree_ = true;
+        }
+
+        void closeElement() {
+            printer_.CloseElement(compact_);
+            valueFree_ = false;
+        }
+
+        void pushAttribute(const char* name, const char* value) {
+            printer_.PushAttribute(name, value);
+        }
+
+        void pushText(const char* text) {
+            printer_.PushText(text);
+            valueFree_ = false;
+        }
+
+        // An element holding only text, like <value>1</value>.
+        void pushElement(const char* name, const char* text) {
+            openElement(name);
+            printer_.PushText(text);
+            closeElement();
+        }
+
+        // A scalar of the compact dialect: attribute v while the current element is still empty, otherwise a <v> child.
+        void pushScalar(const char* text) {
+            if (valueFree_) {
+                printer_.PushAttribute("v", text);
+                valueFree_ = false;
+                return;
+            }
+            pushElement("v", text);
+        }
+
+        // Whether the current element is still empty, so a compact scalar goes into its v attribute.
+        bool valueFree() const {
+            return valueFree_;
+        }
+
+        // The attributes and children of a DOM element, printed as content of the current element.
+        void pushContent(const XMLElement* element) {
+            for (const XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
+                if (!valueFree_) {
+                    throw std::runtime_error("Cannot add an attribute after element content!");
+                }
+                printer_.PushAttribute(attribute->Name(), attribute->Value());
+            }
+            for (const XMLNode* child = element->FirstChild(); child != nullptr; child = child->NextSibling()) {
+                child->Accept(&printer_);
+                valueFree_ = false;
+            }
+            if (element->FirstAttribute() != nullptr) {
+                valueFree_ = false;
+            }
+        }
+
+        const char* CStr() const {
+            return printer_.CStr();
+        }
+
+        size_t CStrSize() const {
+            return printer_.CStrSize() - 1;
+        }
+
+    private:
+        XMLPrinter printer_;
+        XmlMode mode_;
+        bool compact_;
+        bool valueFree_ = false;
+    };
+
+    template<typename T>
+    typename std::enable_if_t<std::is_arithmetic_v<T>, void>
+    serialize_xml_(const T& value, XMLStreamWriter& writer) {
+        char buffer[numberBufferSize];
+        const char* text = formatNumber(value, buffer);
+        if (writer.mode() & Compact) {
+            writer.pushScalar(text);
+        } else {
+            writer.pushElement("value", text);
+        }
+    }
+
+    inline void serialize_xml_(const std::string& str, XMLStreamWriter& writer) {
+        if (writer.mode() & Compact) {
+            writer.pushScalar(str.c_str());
+        } else {
+            writer.pushElement("std_string", str.c_str());
+        }
+    }
+
+    template<typename Container>
+    void serializeContainer_xml(const Container& container, XMLStreamWriter& writer, const char* containerName);
+    template<typename T1, typename T2>
+    void serialize_xml_(const std::pair<T1, T2>& pair, XMLStreamWriter& writer);
+    template<typename T>
+    typename std::enable_if_t<std::is_class_v<T>, void>
+    serialize_xml_(const T& value, XMLStreamWriter& writer);
+
+    template<typename T>
+    void serialize_xml_(const std::vector<T>& vec, XMLStreamWriter& writer) {
+        serializeContainer_xml(vec, writer, "std_vector");
+    }
+
+    template<typename T>
+    void serialize_xml_(const std::list<T>& list, XMLStreamWriter& writer) {
+        serializeContainer_xml(list, writer, "std_list");
+    }
+
+    template<typename Key, typename Value>
+    void serialize_xml_(const std::map<Key, Value>& map, XMLStreamWriter& writer) {
+        serializeContainer_xml(map, writer, "std_map");
+    }
+
+    template<typename T>
+    void serialize_xml_(const std::set<T>& set, XMLStreamWriter& writer) {
+        serializeContainer_xml(set, writer, "std_set");
+    }
+
+    template<typename T1, typename T2>
+    void serialize_xml_(const std::pair<T1, T2>& pair, XMLStreamWriter& writer) {
+        if (writer.mode() & Compact) {
+            serialize_xml_(pair.first, writer);
+            serialize_xml_(pair.second, writer);
+            return;
+        }
+        writer.openElement("std_pair");
+        writer.openElement("first");
+        serialize_xml_(pair.first, writer);
+        writer.closeElement();
+        writer.openElement("second");
+        serialize_xml_(pair.second, writer);
+        writer.closeElement();
+        writer.closeElement();
+    }
+
+    // Types registered with REGISTER_XMLSERIALIZATION print themselves. Types that only have the DOM hook
+    // serialize_xml_(XMLDocument&, XMLElement*) fill a scratch element, whose content is then printed.
+    template<typename T>
+    typename std::enable_if_t<std::is_class_v<T>, void>
+    serialize_xml_(const T& value, XMLStreamWriter& writer) {
+        if constexpr (requires { value.serialize_xml_(writer); }) {
+            value.serialize_xml_(writer);
+        } else {
+            XMLDocument doc;
+            setModeOf(doc, writer.mode());
+            XMLElement* scratch = doc.NewElement("scratch", true);
+            doc.InsertFirstChild(scratch);
+            // Mirror whether the current element already has content, so compact scalars pick attribute v or <v> alike.
+            XMLElement* placeholder = nullptr;
+            if (!writer.valueFree()) {
+                placeholder = doc.NewElement("placeholder", true);
+                scratch->InsertEndChild(placeholder);
+            }
+            value.serialize_xml_(doc, scratch);
+            if (placeholder != nullptr) {
+                scratch->DeleteChild(placeholder);
+            }
+            writer.pushContent(scratch);
+        }
+    }
+
+    template<typename Container>
+    void serializeContainer_xml(const Container& container, XMLStreamWriter& writer, const char* containerName) {
+        writer.openElement(containerName);
+        if constexpr (isPackedNumber_v<typename Container::value_type>) {
+            if (const char* packing = packingOf(writer.mode())) {
+                writer.pushAttribute("packed", packing);
+                writer.pushText(packNumbers_xml(container, packing).c_str());
+                writer.closeElement();
+                return;
+            }
+        }
+        if (writer.mode() & Compact) {
+            for (const auto& element : container) {
+                writer.openElement("e");
+                serialize_xml_(element, writer);
+                writer.closeElement();
+            }
+            writer.closeElement();
+            return;
+        }
+        char buffer[numberBufferSize];
+        writer.pushElement("size", formatNumber(container.size(), buffer));
+        // XMLPrinter keeps the name of an open element until it is closed, so this buffer must outlive the item.
+        char name[indexTagBufferSize];
+        size_t index = 0;
+        for (const auto& element : container) {
+            writer.openElement(indexTag(index, name));
+            serialize_xml_(element, writer);
+            writer.closeElement();
+            ++index;
+        }
+        writer.closeElement();
+    }
+
+    template<typename T>
+    void serializeStreaming_xml(const T& value, XMLStreamWriter& writer) {
+        writer.openElement("serialization");
+        if (writer.mode() & Compact) {
+            writer.pushAttribute("format", "compact");
+        }
+        serialize_xml_(value, writer);
+        writer.closeElement();
+    }
+
+    // Pull-parser input: deserialize_xml_(value, parser) overloads that read the same documents as the DOM ones,
+    // in document order, while the parser streams through the file.
+    inline void expectStart_xml(XMLPullParser& parser, const char* name) {
+        if (parser.next() != XMLPullParser::StartElement || parser.name() != name) {
+            throw std::runtime_error("Unexpected element!");
+        }
+    }
+
+    inline void expectEnd_xml(XMLPullParser& parser) {
+        if (parser.next() != XMLPullParser::EndElement) {
+            throw std::runtime_error("Unexpected element!");
+        }
+    }
+
+    // The text of the element whose start tag was just read, up to its end tag.
+    template<typename Read>
+    void readText_xml(XMLPullParser& parser, Read read) {
+        XMLPullParser::Event event = parser.next();
+        if (event == XMLPullParser::EndElement) {
+            read("");
+            return;
+        }
+        if (event != XMLPullParser::Text) {
+            throw std::runtime_error("Unexpected element!");
+        }
+        read(parser.text().c_str());
+        expectEnd_xml(parser);
+    }
+
+    // A scalar: a <tag> element, or in the compact dialect attribute v of the current element or a <v> child.
+    template<typename Read>
+    void readScalar_xml(XMLPullParser& parser, const char* tag, Read read) {
+        if (modeOf(parser) & Compact) {
+            if (const char* text = parser.attribute("v")) {
+                read(text);
+                parser.removeAttribute("v");
+                return;
+            }
+            tag = "v";
+        }
+        expectStart_xml(parser, tag);
+        readText_xml(parser, read);
+    }
+
+    template<typename T>
+    typename std::enable_if_t<std::is_arithmetic_v<T>, void>
+    deserialize_xml_(T& value, XMLPullParser& parser) {
+        readScalar_xml(parser, "value", [&](const char* text) {
+            parseNumber(text, value);
+        });
+    }
+
+    inline void deserialize_xml_(std::string& str, XMLPullParser& parser) {
+        readScalar_xml(parser, "std_string", [&](const char* text) {
+            str = text;
+        });
+    }
+
+    template<typename Container>
+    void deserializeContainer_xml(Container& container, XMLPullParser& parser, const char* containerName);
+    template<typename Value, typename Key>
+    void deserializeContainer_xml(std::map<Key, Value>& map, XMLPullParser& parser);
+    template<typename T1, typename T2>
+    void deserialize_xml_(std::pair<T1, T2>& pair, XMLPullParser& parser);
+    template<typename T>
+    typename std::enable_if_t<std::is_class_v<T>, void>
+    deserialize_xml_(T& value, XMLPullParser& parser);
+
+    template<typename T>
+    void deserialize_xml_(std::vector<T>& vec, XMLPullParser& parser) {
+        deserializeContainer_xml(vec, parser, "std_vector");
+    }
+
+    template<typename T>
+    void deserialize_xml_(std::list<T>& list, XMLPullParser& parser) {
+        deserializeContainer_xml(list, parser, "std_list");
+    }
+
+    template<typename Key, typename Value>
+    void deserialize_xml_(std::map<Key, Value>& map, XMLPullParser& parser) {
+        deserializeContainer_xml(map, parser);
+    }
+
+    template<typename T>
+    void deserialize_xml_(std::set<T>& set, XMLPullParser& parser) {
+        deserializeContainer_xml(set, parser, "std_set");
+    }
+
+    template<typename T1, typename T2>
+    void deserialize_xml_(std::pair<T1, T2>& pair, XMLPullParser& parser) {
+        if (modeOf(parser) & Compact) {
+            deserialize_xml_(pair.first, parser);
+            deserialize_xml_(pair.second, parser);
+            return;
+        }
+        expectStart_xml(parser, "std_pair");
+        expectStart_xml(parser, "first");
+        deserialize_xml_(pair.first, parser);
+        expectEnd_xml(parser);
+        expectStart_xml(parser, "second");
+        deserialize_xml_(pair.second, parser);
+        expectEnd_xml(parser);
+        expectEnd_xml(parser);
+    }
+
+    // Types that only have the DOM hook deserialize_xml_(XMLDocument&, XMLElement*) may look anywhere in their parent
+    // element, which the pull parser has partly consumed already, so they are read without Streaming.
+    template<typename T>
+    typename std::enable_if_t<std::is_class_v<T>, void>
+    deserialize_xml_(T& value, XMLPullParser& parser) {
+        if constexpr (requires { value.deserialize_xml_(parser); }) {
+            value.deserialize_xml_(parser);
+        } else {
+            throw std::runtime_error("Type has no pull deserializer; read it without Streaming!");
+        }
+    }
+
+    // The items of the container element whose start tag was just read, each read by readItem between its start and end tags.
+    template<typename ReadItem>
+    void forEachItem_xml(XMLPullParser& parser, ReadItem readItem) {
+        bool compact = modeOf(parser) & Compact;
+        bool validate = modeOf(parser) & ValidateIndices;
+        size_t size = 0;
+        if (!compact) {
+            expectStart_xml(parser, "size");
+            readText_xml(parser, [&](const char* text) {
+                parseNumber(text, size);
+            });
+        }
+        char name[indexTagBufferSize];
+        size_t i = 0;
+        XMLPullParser::Event event;
+        while ((event = parser.next()) == XMLPullParser::StartElement) {
+            if (validate) {
+                if (parser.name() != (compact ? "e" : indexTag(i, name))) {
+                    throw std::runtime_error("Invalid container index!");
+                }
+            }
+            readItem();
+            expectEnd_xml(parser);
+            ++i;
+        }
+        if (event != XMLPullParser::EndElement) {
+            throw std::runtime_error("Unexpected element!");
+        }
+        if (validate && !compact && i != size) {
+            throw std::runtime_error("Container size does not match!");
+        }
+    }
+
+    template<typename Container>
+    void deserializeContainer_xml(Container& container, XMLPullParser& parser, const char* containerName) {
+        container.clear();
+        expectStart_xml(parser, containerName);
+        if constexpr (isPackedNumber_v<typename Container::value_type>) {
+            if (const char* packing = parser.attribute("packed")) {
+                bool base64 = std::strcmp(packing, "base64") == 0;
+                readText_xml(parser, [&](const char* text) {
+                    unpackNumbers_xml(container, base64, text);
+                });
+                return;
+            }
+        }
+        typename Container::value_type element{};
+        forEachItem_xml(parser, [&]() {
+            deserialize_xml_(element, parser);
+            container.insert(container.end(), std::move(element));
+        });
+    }
+
+    template<typename Value, typename Key>
+    void deserializeContainer_xml(std::map<Key, Value>& map, XMLPullParser& parser) {
+        map.clear();
+        expectStart_xml(parser, "std_map");
+        std::pair<Key, Value> element{};
+        forEachItem_xml(parser, [&]() {
+            deserialize_xml_(element, parser);
+            map.emplace_hint(map.end(), std::move(element));
+        });
+    }
+
+    template<typename T>
+    void deserializePulling_xml(T& value, XMLPullParser& parser, XmlMode mode) {
+        setModeOf(parser, mode);
+        expectStart_xml(parser, "serialization");
+        const char* format = parser.attribute("format");
+        if (format != nullptr && std::strcmp(format, "compact") == 0) {
+            setModeOf(parser, mode | Compact);
+        }
+        deserialize_xml_(value, parser);
+        expectEnd_xml(parser);
+    }
+
+    /*
+    * The document and print buffers used by one serialize_xml / deserialize_xml call.
+    * A context passed to consecutive calls keeps them alive in between: the document is reset with Clear(), which
+    * returns its nodes to the memory pools instead of freeing them, and the printers keep their buffer capacity.
+    * Files are parsed in place from a copy-on-write mapping (see load), which the context keeps until the next call.
+    * A context must not be shared by threads running at the same time; local() gives each thread its own.
+    */
+    class XmlContext {
+    public:
+        XmlContext() : printer_(nullptr, false), compactPrinter_(nullptr, true) {}
+
+        XmlContext(const XmlContext&) = delete;
+        XmlContext& operator=(const XmlContext&) = delete;
+
+        // The empty document for the next call.
+        XMLDocument& document(XmlMode mode) {
+            doc_.Clear();
+            file_.reset();
+            setModeOf(doc_, mode);
+            return doc_;
+        }
+
+        // The document parsed from the file. The file is mapped instead of read into a buffer, and since
+        // tinyxml2 parses destructively the mapping is private, so only the pages it writes to are copied.
+        XMLDocument& load(const std::string& filename, XmlMode mode) {
+            XMLDocument& doc = document(mode);
+            file_.emplace(filename, true);
+            doc.ParseInPlace(file_->writableData(), file_->size());
+            return doc;
+        }
+
+        // Drop the document and the mapping now rather than at the next call; the pools and buffers stay.
+        void release() {
+            doc_.Clear();
+            file_.reset();
+        }
+
+        // An empty in-memory printer; its text stays valid until the printer is handed out again.
+        XMLPrinter& printer(bool compact) {
+            XMLPrinter& printer = compact ? compactPrinter_ : printer_;
+            printer.ClearBuffer();
+            return printer;
+        }
+
+        // The context of the calling thread.
+        static XmlContext& local() {
+            thread_local XmlContext context;
+            return context;
+        }
+
+    private:
+        // Declared before the document, which refers into it.
+        std::optional<MappedFile> file_;
+        XMLDocument doc_;
+        XMLPrinter printer_;
+        XMLPrinter compactPrinter_;
+    };
+
+    template<typename T>
+    XMLDocument& buildDocument_xml(const T& value, XmlContext& context, XmlMode mode) {
+        XMLDocument& doc = context.document(mode);
+        XMLElement* root = doc.NewElement("serialization", true);
+        doc.InsertFirstChild(root);
+        if (mode & Compact) {
+            root->SetAttribute("format", "compact");
+        }
+        serialize_xml_(value, doc, root);
+        return doc;
+    }
+
+    template<typename T>
+    void readDocument_xml(T& value, XMLDocument& doc, XmlMode mode) {
+        XMLElement* root = doc.FirstChildElement("serialization");
+        if (root != nullptr && root->Attribute("format", "compact") != nullptr) {
+            setModeOf(doc, mode | Compact);
+        }
+        deserialize_xml_(value, doc, root);
     }
 
     /*
@@ -202,52 +998,137 @@ namespace xmlSerialization {
     * @param 
     *     value: the value to be serialized.
     *     filename: the name of the file to store the serialized data.
+    *     mode: the options to use (see XmlMode).
+    *     context: the document and buffers to reuse (see XmlContext).
     */
     template<typename T>
-    void serialize_xml(const T& value, const std::string& filename, bool use_base64 = false) {
-        XMLDocument doc;
-        XMLElement* root = doc.NewElement("serialization");
-        doc.InsertFirstChild(root);
-        serialize_xml_(value, doc, root);
-        if (!use_base64) {
-            doc.SaveFile(filename.c_str());
+    void serialize_xml(const T& value, const std::string& filename, XmlMode mode, XmlContext& context) {
+        if ((mode & Streaming) && !(mode & Base64)) {
+            std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(filename.c_str(), "w"), &std::fclose);
+            if (file == nullptr) {
+                throw std::runtime_error("File cannot be created!");
+            }
+            XMLStreamWriter writer(file.get(), mode);
+            serializeStreaming_xml(value, writer);
+            return;
+        }
+        if (mode & Streaming) {
+            XMLStreamWriter writer(nullptr, mode);
+            serializeStreaming_xml(value, writer);
+            std::ofstream file(filename);
+            file << base64_encode(reinterpret_cast<const unsigned char*>(writer.CStr()), writer.CStrSize());
+            return;
+        }
+        bool compact = mode & Compact;
+        XMLDocument& doc = buildDocument_xml(value, context, mode);
+        if (!(mode & Base64)) {
+            doc.SaveFile(filename.c_str(), compact);
             return;
         }
-        std::string data;
-        XMLPrinter printer;
+        XMLPrinter& printer = context.printer(compact);
         doc.Print(&printer);
-        data = printer.CStr();
         std::ofstream file(filename);
-        file << base64_encode(reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
+        file << base64_encode(reinterpret_cast<const unsigned char*>(printer.CStr()), printer.CStrSize() - 1);
         file.close();
     }
 
+    template<typename T>
+    void serialize_xml(const T& value, const std::string& filename, XmlMode mode) {
+        XmlContext context;
+        serialize_xml(value, filename, mode, context);
+    }
+
+    template<typename T>
+    void serialize_xml(const T& value, const std::string& filename, bool use_base64 = false) {
+        serialize_xml(value, filename, use_base64 ? Base64 : XmlDefault);
+    }
+
+    /*
+    * Serialize the value to XML text in memory. Base64 and Streaming are ignored.
+    * @param
+    *     value: the value to be serialized.
+    *     context: the document and buffers to reuse (see XmlContext).
+    *     mode: the options to use (see XmlMode).
+    * @return the text, owned by the context and valid until its next use.
+    */
+    template<typename T>
+    const char* serialize_xml(const T& value, XmlContext& context, XmlMode mode = XmlDefault) {
+        XMLDocument& doc = buildDocument_xml(value, context, mode);
+        XMLPrinter& printer = context.printer(mode & Compact);
+        doc.Print(&printer);
+        return printer.CStr();
+    }
+
     /*
     * Deserialize the value from the file with the given filename.
     * @param
     *    value: the value to be deserialized.
     *   filename: the name of the file to read the serialized data.
+    *   mode: the options to use (see XmlMode); files written with Compact are recognised without it.
+    *   context: the document to reuse (see XmlContext).
     */
     template<typename T>
-    void deserialize_xml(T& value, const std::string& filename, bool use_base64 = false) {
-        if (!use_base64) {
-            XMLDocument doc;
-            doc.LoadFile(filename.c_str());
-            XMLElement* root = doc.FirstChildElement("serialization");
-            deserialize_xml_(value, doc, root);
-        } else {
-            std::ifstream file(filename);
-            std::string data, line;
-            while (std::getline(file, line)) {
-                data += line;
+    void deserialize_xml(T& value, const std::string& filename, XmlMode mode, XmlContext& context) {
+        if ((mode & Streaming) && !(mode & Base64)) {
+            std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(filename.c_str(), "rb"), &std::fclose);
+            if (file == nullptr) {
+                throw std::runtime_error("File not found!");
             }
-            file.close();
-            std::string decoded = base64_decode(data);
-            XMLDocument doc;
-            doc.Parse(decoded.c_str());
-            XMLElement* root = doc.FirstChildElement("serialization");
-            deserialize_xml_(value, doc, root);
+            XMLPullParser parser(file.get());
+            deserializePulling_xml(value, parser, mode);
+            return;
+        }
+        if (!(mode & Base64)) {
+            readDocument_xml(value, context.load(filename, mode), mode);
+            context.release();
+            return;
+        }
+        std::ifstream file(filename);
+        std::string data, line;
+        while (std::getline(file, line)) {
+            data += line;
         }
+        file.close();
+        std::string decoded = base64_decode(data);
+        if (mode & Streaming) {
+            XMLPullParser parser(decoded.data(), decoded.size());
+            deserializePulling_xml(value, parser, mode);
+            return;
+        }
+        XMLDocument& doc = context.document(mode);
+        doc.Parse(decoded.c_str(), decoded.size());
+        readDocument_xml(value, doc, mode);
+    }
+
+    template<typename T>
+    void deserialize_xml(T& value, const std::string& filename, XmlMode mode) {
+        XmlContext context;
+        deserialize_xml(value, filename, mode, context);
+    }
+
+    /*
+    * Deserialize the value from XML text in memory, as returned by the in-memory serialize_xml.
+    * @param
+    *     value: the value to be deserialized.
+    *     xml: the NUL-terminated text.
+    *     context: the document to reuse (see XmlContext).
+    *     mode: the options to use (see XmlMode); Base64 is ignored.
+    */
+    template<typename T>
+    void deserialize_xml(T& value, const char* xml, XmlContext& context, XmlMode mode = XmlDefault) {
+        if (mode & Streaming) {
+            XMLPullParser parser(xml, std::strlen(xml));
+            deserializePulling_xml(value, parser, mode);
+            return;
+        }
+        XMLDocument& doc = context.document(mode);
+        doc.Parse(xml);
+        readDocument_xml(value, doc, mode);
+    }
+
+    template<typename T>
+    void deserialize_xml(T& value, const std::string& filename, bool use_base64 = false) {
+        deserialize_xml(value, filename, use_base64 ? Base64 : XmlDefault);
     }
 
 }
@@ -259,6 +1140,12 @@ namespace xmlSerialization {
     } \
     void deserialize_xml_(XMLDocument& doc, XMLElement* parent) { \
         xmlSerialization::registerFunction([&](auto& member){xmlSerialization::deserialize_xml_(member, doc, parent);}, __VA_ARGS__); \
+    } \
+    void serialize_xml_(xmlSerialization::XMLStreamWriter& writer) const { \
+        xmlSerialization::registerConstFunction([&](const auto& member){xmlSerialization::serialize_xml_(member, writer);}, __VA_ARGS__); \
+    } \
+    void deserialize_xml_(xmlSerialization::XMLPullParser& parser) { \
+        xmlSerialization::registerFunction([&](auto& member){xmlSerialization::deserialize_xml_(member, parser);}, __VA_ARGS__); \
     }
 
 